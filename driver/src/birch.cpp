@@ -133,6 +133,8 @@ int main(int argc, char** argv) {
       driver.build();
     } else if (prog.compare("install") == 0) {
       driver.install();
+    } else if (prog.compare("pgo") == 0) {
+      driver.pgo();
     } else if (prog.compare("uninstall") == 0) {
       driver.uninstall();
     } else if (prog.compare("dist") == 0) {
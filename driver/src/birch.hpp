@@ -19,9 +19,13 @@
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include <numeric>
 #include <functional>
 #include <regex>
 #include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
 #include <iomanip>
 #include <locale>
 #include <codecvt>
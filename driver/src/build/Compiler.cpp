@@ -5,96 +5,194 @@
 
 #include "src/birch.hpp"
 #include "src/lexer.hpp"
+#include "src/parser.hpp"
 #include "src/visitor/all.hpp"
 #include "src/generate/CppGenerator.hpp"
+#include "src/generate/CppMainGenerator.hpp"
 #include "src/generate/CppPackageGenerator.hpp"
 #include "src/primitive/string.hpp"
 
-birch::Compiler* compiler = nullptr;
-std::stringstream raw;
-
-birch::Compiler::Compiler(Package* package, const std::string& unit) :
+birch::Compiler::Compiler(Package* package, const std::string& unit,
+    const int jobs) :
     package(package),
-    unit(unit) {
+    unit(unit),
+    jobs(jobs) {
   //
 }
 
 void birch::Compiler::parse() {
-  compiler = this;  // set global variable needed by parser for callbacks
-  auto files = package->sources;
-  for (auto file : files) {
-    raw.str("");
-    auto fd = fopen(file->path.c_str(), "r");
-    if (!fd) {
-      throw FileNotFoundException(file->path);
-    }
-    this->file = file;  // member variable needed by GNU Bison parser
-    yyrestart(fd);
-    yyreset();
-    try {
-      yyparse();
-    } catch (birch::Exception& e) {
-      yyerror(e.msg.c_str());
-    }
-    yylex_destroy();
-    fclose(fd);
-    this->file = nullptr;
-  }
-  compiler = nullptr;
+  std::vector<File*> files(package->sources.begin(), package->sources.end());
+  parallel(files.size(), [&](size_t i) {
+        auto file = files[i];
+        auto fd = fopen(file->path.c_str(), "r");
+        if (!fd) {
+          throw FileNotFoundException(file->path);
+        }
+        ParserState state(file);
+        yyscan_t scanner;
+        yylex_init_extra(&state, &scanner);
+        yyset_in(fd, scanner);
+        try {
+          yyparse(scanner);
+        } catch (birch::Exception& e) {
+          yyerror(yyget_lloc(scanner), scanner, e.msg.c_str());
+        }
+        yylex_destroy(scanner);
+        fclose(fd);
+      });
 }
 
-void birch::Compiler::gen(const bool includeLines) {
-  std::stringstream stream;
-  std::string tarName = tar(package->name);
-  fs::path path = fs::path(tarName);
-
-  CppPackageGenerator hppOutput(stream, 0, true, false, includeLines);
-  CppGenerator cppOutput(stream, 0, false, false, includeLines);
+void birch::Compiler::infer(std::ostream* report) {
+  AcyclicInferrer acyclic(report);
+  package->accept(&acyclic);
+  InplaceInferrer inplace(report);
+  package->accept(&inplace);
+  ExactInferrer exact;
+  package->accept(&exact);
+}
 
-  /* single *.hpp header for whole package */
-  stream.str("");
-  hppOutput << package;
-  path.replace_extension(".hpp");
-  write_all_if_different(path, stream.str());
+void birch::Compiler::gen(const bool includeLines, const bool instantiate,
+    const bool executable) {
+  std::string tarName = tar(package->name);
 
+  /* output files, other than the header, and the source files that go into
+   * each */
+  std::vector<std::pair<fs::path,std::list<File*>>> outputs;
   if (unit == "unity") {
     /* sources go into one *.cpp file for the whole package */
-    stream.str("");
-    for (auto file : package->sources) {
-      cppOutput << file;
-    }
+    fs::path path = fs::path(tarName);
     path.replace_extension(".cpp");
-    write_all_if_different(path, stream.str());
+    outputs.push_back(std::make_pair(path, package->sources));
   } else if (unit == "file") {
     /* sources go into one *.cpp file for each *.birch file */
     for (auto file : package->sources) {
-      stream.str("");
-      cppOutput << file;
-      path = file->path;
+      fs::path path = file->path;
       path.replace_extension(".cpp");
-      write_all_if_different(path, stream.str());
+      outputs.push_back(std::make_pair(path, std::list<File*>{ file }));
+    }
+  } else if (unit == "balanced") {
+    /* sources go into a number of *.cpp files, one for each job, balanced by
+     * estimated cost; files are assigned, most costly first, to the output
+     * with the least cost so far */
+    std::vector<File*> files(package->sources.begin(),
+        package->sources.end());
+    std::vector<size_t> costs(files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+      CostEstimator estimator;
+      files[i]->accept(&estimator);
+      costs[i] = estimator.cost();
+    }
+    std::vector<size_t> order(files.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t i, size_t j) {
+          return costs[i] > costs[j];
+        });
+
+    size_t n = units(jobs, files.size());
+    std::vector<size_t> loads(n, 0);
+    std::vector<std::vector<size_t>> parts(n);
+    for (auto i : order) {
+      auto j = std::min_element(loads.begin(), loads.end()) - loads.begin();
+      loads[j] += costs[i];
+      parts[j].push_back(i);
+    }
+    for (size_t j = 0; j < n; ++j) {
+      /* restore the original order of files within each output */
+      std::sort(parts[j].begin(), parts[j].end());
+      std::list<File*> sources;
+      for (auto i : parts[j]) {
+        sources.push_back(files[i]);
+      }
+      fs::path path = fs::path(tarName + "_" + std::to_string(j));
+      path.replace_extension(".cpp");
+      outputs.push_back(std::make_pair(path, sources));
     }
   } else {
     /* sources go into one *.cpp file for each directory */
-    std::unordered_map<std::string,std::string> sources;
+    std::unordered_map<std::string,size_t> dirs;
     for (auto file : package->sources) {
       auto dir = fs::path(file->path).parent_path().string();
-      auto iter = sources.find(dir);
-      if (iter == sources.end()) {
-        iter = sources.insert(std::make_pair(dir, std::string(""))).first;
+      auto iter = dirs.find(dir);
+      if (iter == dirs.end()) {
+        fs::path path = fs::path(dir) / tarName;
+        path.replace_extension(".cpp");
+        iter = dirs.insert(std::make_pair(dir, outputs.size())).first;
+        outputs.push_back(std::make_pair(path, std::list<File*>()));
       }
-      stream.str("");
-      cppOutput << file;
-      iter->second += stream.str();
-    }
-    for (auto pair : sources) {
-      path = fs::path(pair.first) / tarName;
-      path.replace_extension(".cpp");
-      write_all_if_different(path, pair.second);
+      outputs[iter->second].second.push_back(file);
     }
   }
+
+  /* the first task generates the single *.hpp header for the whole package,
+   * the second the main function for a standalone executable, if enabled,
+   * the remainder each generate one *.cpp file */
+  parallel(outputs.size() + 2, [&](size_t i) {
+        std::stringstream stream;
+        if (i == 0) {
+          CppPackageGenerator hppOutput(stream, 0, true, false, includeLines,
+              instantiate);
+          hppOutput << package;
+          fs::path path = fs::path(tarName);
+          path.replace_extension(".hpp");
+          write_all_if_different(path, stream.str());
+        } else if (i == 1) {
+          if (!executable) {
+            return;
+          }
+          CppMainGenerator mainOutput(stream);
+          mainOutput << package;
+          fs::path path = fs::path(tarName + "-main");
+          path.replace_extension(".cpp");
+          write_all_if_different(path, stream.str());
+        } else {
+          auto& output = outputs[i - 2];
+          CppGenerator cppOutput(stream, 0, false, false, includeLines);
+          for (auto file : output.second) {
+            cppOutput << file;
+          }
+          if (i == 2) {
+            CppPackageGenerator instOutput(stream, 0, false, false,
+                includeLines, instantiate);
+            instOutput << package;
+          }
+          write_all_if_different(output.first, stream.str());
+        }
+      });
+}
+
+int birch::Compiler::units(const int jobs, const size_t nsources) {
+  return int(std::max(std::min(size_t(std::max(jobs, 1)), nsources),
+      size_t(1)));
 }
 
-void birch::Compiler::setRoot(Statement* root) {
-  this->file->root = root;
+void birch::Compiler::parallel(const size_t n,
+    const std::function<void(size_t)>& f) {
+  std::atomic<size_t> next(0);
+  std::exception_ptr error;
+  std::mutex mutex;
+  auto work = [&]() {
+    for (size_t i = next++; i < n; i = next++) {
+      try {
+        f(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }
+  };
+
+  size_t nthreads = std::min(size_t(std::max(jobs, 1)), n);
+  std::vector<std::thread> threads;
+  for (size_t j = 1; j < nthreads; ++j) {
+    threads.emplace_back(work);
+  }
+  work();  // this thread is the first job
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
 }
@@ -20,32 +20,64 @@ public:
    *
    * @param package The package.
    * @param unit Compilation unit.
+   * @param jobs Number of threads with which to parse and generate.
    */
-  Compiler(Package* package, const std::string& unit);
+  Compiler(Package* package, const std::string& unit, const int jobs = 1);
 
   /**
-   * Parse source files.
+   * Parse source files. With more than one job, files are parsed
+   * concurrently.
    */
   void parse();
 
   /**
-   * Generate output code for all input files.
+   * Infer annotations that require analysis of the package as a whole,
+   * such as acyclic classes, local variables that may be allocated inplace,
+   * and member function calls that may be devirtualized.
+   *
+   * @param report Output stream for a report of the inferences made, or
+   * `nullptr` for no report.
+   */
+  void infer(std::ostream* report = nullptr);
+
+  /**
+   * Generate output code for all input files. With more than one job, output
+   * files are generated concurrently.
    * 
    * @param includeLines Include #line annotations?
+   * @param instantiate Explicitly instantiate the generic classes of the
+   * package that are used by the package? The instantiations are defined in
+   * the first output file and declared `extern` in the header.
+   * @param executable Generate the main function for a standalone
+   * executable?
    */
-  void gen(const bool includeLines);
+  void gen(const bool includeLines, const bool instantiate = false,
+      const bool executable = false);
 
   /**
-   * Set the root statement of the current file.
+   * Number of output files when the compilation unit is `balanced`: the
+   * number of jobs, but no more than the number of source files, and at
+   * least one. Also used by the driver to list the output files in the
+   * build system, so that the two agree.
+   *
+   * @param jobs Number of jobs.
+   * @param nsources Number of source files.
    */
-  void setRoot(Statement* root);
+  static int units(const int jobs, const size_t nsources);
 
+private:
   /**
-   * Current file being parsed (needed by GNU Bison parser).
+   * Call a function for each of a number of tasks, distributing them among
+   * the jobs.
+   *
+   * @param n Number of tasks.
+   * @param f Function, taking the index of the task.
+   *
+   * If any task throws an exception, the first such is rethrown once all
+   * jobs have finished.
    */
-  File* file;
+  void parallel(const size_t n, const std::function<void(size_t)>& f);
 
-private:
   /**
    * Package.
    */
@@ -55,8 +87,10 @@ private:
    * Compilation unit.
    */
   std::string unit;
+
+  /**
+   * Number of jobs.
+   */
+  int jobs;
 };
 }
-
-extern birch::Compiler* compiler;
-extern std::stringstream raw;
@@ -22,6 +22,11 @@ birch::Driver::Driver(int argc, char** argv) :
     staticLib(false),
     sharedLib(true),
     openmp(true),
+    lto(true),
+    precompile(false),
+    instantiate(false),
+    executable(false),
+    staticExecutable(false),
     warnings(true),
     notes(true),
     translate(true),
@@ -130,6 +135,7 @@ birch::Driver::Driver(int argc, char** argv) :
     ARCH_ARG,
     MODE_ARG,
     UNIT_ARG,
+    BIND_ARG,
     ENABLE_DEBUG_ARG,
     DISABLE_DEBUG_ARG,
     ENABLE_TEST_ARG,
@@ -142,7 +148,18 @@ birch::Driver::Driver(int argc, char** argv) :
     DISABLE_SHARED_ARG,
     ENABLE_OPENMP_ARG,
     DISABLE_OPENMP_ARG,
+    ENABLE_PRECOMPILE_ARG,
+    DISABLE_PRECOMPILE_ARG,
+    ENABLE_INSTANTIATE_ARG,
+    DISABLE_INSTANTIATE_ARG,
+    ENABLE_EXECUTABLE_ARG,
+    DISABLE_EXECUTABLE_ARG,
+    ENABLE_STATIC_EXECUTABLE_ARG,
+    DISABLE_STATIC_EXECUTABLE_ARG,
     JOBS_ARG,
+    PGO_ARG,
+    ENABLE_LTO_ARG,
+    DISABLE_LTO_ARG,
     ENABLE_WARNINGS_ARG,
     DISABLE_WARNINGS_ARG,
     ENABLE_NOTES_ARG,
@@ -160,7 +177,11 @@ birch::Driver::Driver(int argc, char** argv) :
       { "arch", required_argument, 0, ARCH_ARG },
       { "unit", required_argument, 0, UNIT_ARG },
       { "mode", required_argument, 0, MODE_ARG },
+      { "bind", required_argument, 0, BIND_ARG },
       { "jobs", required_argument, 0, JOBS_ARG },
+      { "pgo", required_argument, 0, PGO_ARG },
+      { "enable-lto", no_argument, 0, ENABLE_LTO_ARG },
+      { "disable-lto", no_argument, 0, DISABLE_LTO_ARG },
       { "enable-test", no_argument, 0, ENABLE_TEST_ARG },
       { "disable-test", no_argument, 0, DISABLE_TEST_ARG },
       { "enable-debug", no_argument, 0, ENABLE_DEBUG_ARG },
@@ -173,6 +194,16 @@ birch::Driver::Driver(int argc, char** argv) :
       { "disable-shared", no_argument, 0, DISABLE_SHARED_ARG },
       { "enable-openmp", no_argument, 0, ENABLE_OPENMP_ARG },
       { "disable-openmp", no_argument, 0, DISABLE_OPENMP_ARG },
+      { "enable-precompile", no_argument, 0, ENABLE_PRECOMPILE_ARG },
+      { "disable-precompile", no_argument, 0, DISABLE_PRECOMPILE_ARG },
+      { "enable-instantiate", no_argument, 0, ENABLE_INSTANTIATE_ARG },
+      { "disable-instantiate", no_argument, 0, DISABLE_INSTANTIATE_ARG },
+      { "enable-executable", no_argument, 0, ENABLE_EXECUTABLE_ARG },
+      { "disable-executable", no_argument, 0, DISABLE_EXECUTABLE_ARG },
+      { "enable-static-executable", no_argument, 0,
+          ENABLE_STATIC_EXECUTABLE_ARG },
+      { "disable-static-executable", no_argument, 0,
+          DISABLE_STATIC_EXECUTABLE_ARG },
       { "enable-warnings", no_argument, 0, ENABLE_WARNINGS_ARG },
       { "disable-warnings", no_argument, 0, DISABLE_WARNINGS_ARG },
       { "enable-notes", no_argument, 0, ENABLE_NOTES_ARG },
@@ -209,9 +240,21 @@ birch::Driver::Driver(int argc, char** argv) :
     case MODE_ARG:
       mode = optarg;
       break;
+    case BIND_ARG:
+      bind = optarg;
+      break;
     case JOBS_ARG:
       jobs = atoi(optarg);
       break;
+    case PGO_ARG:
+      pgoMode = optarg;
+      break;
+    case ENABLE_LTO_ARG:
+      lto = true;
+      break;
+    case DISABLE_LTO_ARG:
+      lto = false;
+      break;
     case ENABLE_TEST_ARG:
       test = true;
       break;
@@ -248,6 +291,30 @@ birch::Driver::Driver(int argc, char** argv) :
     case DISABLE_OPENMP_ARG:
       openmp = false;
       break;
+    case ENABLE_PRECOMPILE_ARG:
+      precompile = true;
+      break;
+    case DISABLE_PRECOMPILE_ARG:
+      precompile = false;
+      break;
+    case ENABLE_INSTANTIATE_ARG:
+      instantiate = true;
+      break;
+    case DISABLE_INSTANTIATE_ARG:
+      instantiate = false;
+      break;
+    case ENABLE_EXECUTABLE_ARG:
+      executable = true;
+      break;
+    case DISABLE_EXECUTABLE_ARG:
+      executable = false;
+      break;
+    case ENABLE_STATIC_EXECUTABLE_ARG:
+      staticExecutable = true;
+      break;
+    case DISABLE_STATIC_EXECUTABLE_ARG:
+      staticExecutable = false;
+      break;
     case ENABLE_WARNINGS_ARG:
       warnings = true;
       break;
@@ -291,12 +358,19 @@ birch::Driver::Driver(int argc, char** argv) :
   if (!arch.empty() && arch != "native") {
     throw DriverException("--arch must be native, or empty.");
   }
-  if (unit != "unity" && unit != "dir" && unit != "file") {
-    throw DriverException("--unit must be unity, dir, or file.");
+  if (unit != "unity" && unit != "dir" && unit != "file" &&
+      unit != "balanced") {
+    throw DriverException("--unit must be unity, dir, file, or balanced.");
   }
   if (mode != "debug" && mode != "test" && mode != "release") {
     throw DriverException("--mode must be debug, test, or release.");
   }
+  if (!bind.empty() && bind != "close" && bind != "spread") {
+    throw DriverException("--bind must be close, spread, or empty.");
+  }
+  if (!pgoMode.empty() && pgoMode != "generate" && pgoMode != "use") {
+    throw DriverException("--pgo must be generate, use, or empty.");
+  }
 }
 
 void birch::Driver::run(const std::string& prog,
@@ -327,6 +401,13 @@ void birch::Driver::run(const std::string& prog,
   so.replace_extension(".so");
   #endif
 
+  /* thread binding; the OpenMP runtime reads these when the library is
+   * loaded, below */
+  if (!bind.empty()) {
+    setenv("OMP_PROC_BIND", bind.c_str(), 1);
+    setenv("OMP_PLACES", "cores", 0);  // keep any places set by the user
+  }
+
   /* dynamically load possible programs */
   typedef int prog_t(int argc, char** argv);
   void* handle;
@@ -437,7 +518,8 @@ void birch::Driver::configure() {
     } else {
       options << " --disable-release";
     }
-    if (staticLib) {
+    if (staticLib || staticExecutable) {
+      /* a fully static executable links the static library */
       options << " --enable-static";
     } else {
       options << " --disable-static";
@@ -459,6 +541,21 @@ void birch::Driver::configure() {
     } else {
       options << " --disable-openmp";
     }
+    if (precompile) {
+      options << " --enable-precompile";
+    } else {
+      options << " --disable-precompile";
+    }
+    if (executable) {
+      options << " --enable-executable";
+    } else {
+      options << " --disable-executable";
+    }
+    if (staticExecutable) {
+      options << " --enable-static-executable";
+    } else {
+      options << " --disable-static-executable";
+    }
     if (!prefix.empty()) {
       options << " --prefix=" << prefix;
     }
@@ -597,6 +694,13 @@ void birch::Driver::clean() {
   fs::remove(tarName + ".birch");
   fs::remove(tarName + ".cpp");
   fs::remove(tarName + ".hpp");
+  fs::remove(tarName + "-main.cpp");
+  fs::remove(canonicalName + "_test-" + tarName + "-main.o");
+  fs::remove(canonicalName + "_debug-" + tarName + "-main.o");
+  fs::remove(canonicalName + "-" + tarName + "-main.o");
+  fs::remove(tarName + "-test");
+  fs::remove(tarName + "-debug");
+  fs::remove(tarName);
 
   if (unit == "unity") {
     /* sources go into one *.cpp file for the whole package */
@@ -633,6 +737,22 @@ void birch::Driver::clean() {
         fs::remove(object);
       }
     }
+  } else if (unit == "balanced") {
+    /* sources go into one *.cpp file for each job */
+    for (int j = 0; j < units(); ++j) {
+      fs::path source = tarName + "_" + std::to_string(j);
+      source.replace_extension(".cpp");
+      fs::remove(source);
+      source.replace_extension(".lo");
+
+      fs::path object;
+      object = "lib" + canonicalName + "_test_la-" + source.string();
+      fs::remove(object);
+      object = "lib" + canonicalName + "_debug_la-" + source.string();
+      fs::remove(object);
+      object = "lib" + canonicalName + "_la-" + source.string();
+      fs::remove(object);
+    }
   } else {
     /* sources go into one *.cpp file for each directory */
     std::unordered_set<std::string> sources;
@@ -658,6 +778,29 @@ void birch::Driver::clean() {
   }
 }
 
+void birch::Driver::pgo() {
+  /* the first argument is the program to run to collect the profile, the
+   * remainder are passed to it */
+  if (largv.size() < 2) {
+    throw DriverException("birch pgo requires a program to run, e.g. birch pgo sample --config input/smoke.json.");
+  }
+  std::string prog = largv[1];
+  largv.erase(largv.begin());
+
+  /* objects are removed between builds, as make does not otherwise rebuild
+   * them when the flags change */
+  fs::remove_all(fs::path("build") / "pgo");
+  pgoMode = "generate";
+  configure();
+  target("clean");
+  target();
+  run(prog);
+
+  pgoMode = "use";
+  target("clean");
+  target();
+}
+
 void birch::Driver::init() {
   fs::create_directory("src");
   fs::create_directory("config");
@@ -734,7 +877,7 @@ void birch::Driver::docs() {
   Package* package = createPackage();
 
   /* parse all files */
-  Compiler compiler(package, unit);
+  Compiler compiler(package, unit, jobs);
   compiler.parse();
 
   /* output everything into single file */
@@ -857,6 +1000,11 @@ void birch::Driver::help() {
       std::cout << "  --mode (default `debug`, valid values `debug`, `test`, `release`):" << std::endl;
       std::cout << "  Set the mode of the build to run." << std::endl;
       std::cout << std::endl;
+      std::cout << "  --bind (default empty, valid values `close`, `spread`):" << std::endl;
+      std::cout << "  When running a program, bind threads to cores, either close together or" << std::endl;
+      std::cout << "  spread across sockets, by setting OMP_PROC_BIND (and OMP_PLACES, if not" << std::endl;
+      std::cout << "  already set). If empty, the OpenMP runtime default is used." << std::endl;
+      std::cout << std::endl;
       std::cout << "  --enable-debug / --disable-debug (default enabled):" << std::endl;
       std::cout << "  Enable/disable debug mode build." << std::endl;
       std::cout << std::endl;
@@ -878,8 +1026,38 @@ void birch::Driver::help() {
       std::cout << "  --enable-verbose / --disable-verbose (default disabled):" << std::endl;
       std::cout << "  Show all compiler output." << std::endl;
       std::cout << std::endl;
-      std::cout << "  --unit (default `dir`, valid values `unity`, `dir`, `file`):" << std::endl;
-      std::cout << "  Set the compile unit to use when transpiling Birch to C++." << std::endl;
+      std::cout << "  --unit (default `dir`, valid values `unity`, `dir`, `file`, `balanced`):" << std::endl;
+      std::cout << "  Set the compile unit to use when transpiling Birch to C++. If `balanced`," << std::endl;
+      std::cout << "  source files are grouped into one compile unit for each job (see --jobs)," << std::endl;
+      std::cout << "  of roughly equal estimated cost." << std::endl;
+      std::cout << std::endl;
+      std::cout << "  --enable-lto / --disable-lto (default enabled):" << std::endl;
+      std::cout << "  Enable/disable link-time optimization." << std::endl;
+      std::cout << std::endl;
+      std::cout << "  --pgo (default empty, valid values `generate`, `use`):" << std::endl;
+      std::cout << "  Build with instrumentation to generate a profile, or use a previously" << std::endl;
+      std::cout << "  generated profile, for profile-guided optimization. See also `birch pgo`." << std::endl;
+      std::cout << std::endl;
+      std::cout << "  --enable-precompile / --disable-precompile (default disabled):" << std::endl;
+      std::cout << "  Enable/disable a precompiled package header, so that each compile unit does" << std::endl;
+      std::cout << "  not parse it, and the headers that it includes, anew. Most beneficial with" << std::endl;
+      std::cout << "  `--unit=dir` or `--unit=file`. Requires a compiler that supports GCC-style" << std::endl;
+      std::cout << "  *.gch directories." << std::endl;
+      std::cout << std::endl;
+      std::cout << "  --enable-executable / --disable-executable (default disabled):" << std::endl;
+      std::cout << "  Enable/disable a standalone executable for each of the debug, test and" << std::endl;
+      std::cout << "  release builds, named after the package, which runs programs without the" << std::endl;
+      std::cout << "  driver, e.g. `birch-example sample [options...]`." << std::endl;
+      std::cout << std::endl;
+      std::cout << "  --enable-static-executable / --disable-static-executable (default disabled):" << std::endl;
+      std::cout << "  As --enable-executable, but link the executables fully statically. This" << std::endl;
+      std::cout << "  requires static libraries of all dependencies." << std::endl;
+      std::cout << std::endl;
+      std::cout << "  --enable-instantiate / --disable-instantiate (default disabled):" << std::endl;
+      std::cout << "  Enable/disable explicit instantiation of the generic classes of the package" << std::endl;
+      std::cout << "  with the type arguments that the package uses, once, rather than in each" << std::endl;
+      std::cout << "  compile unit of the package and of packages that depend on it. All member" << std::endl;
+      std::cout << "  functions are instantiated, so each must be valid for those type arguments." << std::endl;
       std::cout << std::endl;
       std::cout << "  --prefix (default imputed):" << std::endl;
       std::cout << "  Installation prefix. Defaults to the same prefix used when installing the birch" << std::endl;
@@ -891,6 +1069,23 @@ void birch::Driver::help() {
       std::cout << "  https://docs.birch.sh/libraries/Standard/programs/configure/" << std::endl;
       std::cout << "  https://docs.birch.sh/libraries/Standard/programs/build/" << std::endl;
       std::cout << "  https://docs.birch.sh/libraries/Standard/programs/install/" << std::endl;
+    } else if (command.compare("pgo") == 0) {
+      std::cout << "Usage:" << std::endl;
+      std::cout << std::endl;
+      std::cout << "  birch pgo <program> [options...]" << std::endl;
+      std::cout << std::endl;
+      std::cout << "Build the package with profile-guided optimization: build it with" << std::endl;
+      std::cout << "instrumentation, run <program> with [options...] to generate a profile, then" << std::endl;
+      std::cout << "rebuild it using that profile. The program should be representative of the" << std::endl;
+      std::cout << "intended workload, but quick, e.g." << std::endl;
+      std::cout << std::endl;
+      std::cout << "  birch pgo sample --mode release --config input/smoke.json" << std::endl;
+      std::cout << std::endl;
+      std::cout << "Build options, as for `birch build`, may also be given." << std::endl;
+      std::cout << std::endl;
+      std::cout << "More information is available at:" << std::endl;
+      std::cout << std::endl;
+      std::cout << "  https://docs.birch.sh/libraries/Standard/programs/pgo/" << std::endl;
     } else if (command.compare("uninstall") == 0) {
       std::cout << "Usage:" << std::endl;
       std::cout << std::endl;
@@ -954,6 +1149,7 @@ void birch::Driver::help() {
     std::cout << "  configure     Bootstrap and configure the package." << std::endl;
     std::cout << "  build         Bootstrap, configure and build the package." << std::endl;
     std::cout << "  install       Bootstrap, configure, build and install the package." << std::endl;
+    std::cout << "  pgo           Build the package with profile-guided optimization." << std::endl;
     std::cout << "  uninstall     Uninstall the package." << std::endl;
     std::cout << "  dist          Build the package source tarball." << std::endl;
     std::cout << "  docs          Build the package documentation." << std::endl;
@@ -968,6 +1164,8 @@ void birch::Driver::help() {
     std::cout << std::endl;
     std::cout << "  birch <program> [options...]" << std::endl;
     std::cout << std::endl;
+    std::cout << "where [options...] may include --mode and --bind, as for `birch build`." << std::endl;
+    std::cout << std::endl;
     std::cout << "More information is available at:" << std::endl;
     std::cout << std::endl;
     std::cout << "  https://docs.birch.sh/" << std::endl;
@@ -1105,6 +1303,13 @@ void birch::Driver::setup() {
         makeStream << " \\\n  " << source.string();
       }
     }
+  } else if (unit == "balanced") {
+    /* sources go into one *.cpp file for each job */
+    for (int j = 0; j < units(); ++j) {
+      auto source = fs::path(tarName + "_" + std::to_string(j));
+      source.replace_extension(".cpp");
+      makeStream << " \\\n  " << source.string();
+    }
   } else {
     /* sources go into one *.cpp file for each directory */
     std::unordered_set<std::string> sources;
@@ -1145,9 +1350,114 @@ void birch::Driver::setup() {
 }
 
 void birch::Driver::transpile() {
-  Compiler compiler(createPackage(), unit);
+  using clock = std::chrono::steady_clock;
+  auto elapsed = [](const clock::time_point& from) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        clock::now() - from).count();
+  };
+
+  /* the package header is generated last, so if it is missing then so may
+   * be other output, regardless of the manifest */
+  auto manifestPath = fs::path("build") / "transpile.manifest";
+  auto hppPath = fs::path(tar(packageName) + ".hpp");
+  auto contents = manifest();
+  std::string previous;
+  if (fs::exists(manifestPath) && fs::exists(hppPath)) {
+    previous = read_all(manifestPath);
+  }
+  if (contents == previous) {
+    if (verbose) {
+      std::cerr << "transpile: up to date" << std::endl;
+    }
+    return;
+  }
+  if (verbose) {
+    std::istringstream before(previous), after(contents);
+    std::set<std::string> lines;
+    std::string line;
+    while (std::getline(before, line)) {
+      lines.insert(line);
+    }
+    int total = 0, changed = 0;
+    while (std::getline(after, line)) {
+      if (line.find('\t') != std::string::npos) {
+        ++total;
+        changed += lines.count(line) == 0;
+      }
+    }
+    std::cerr << "transpile: " << changed << " of " << total <<
+        " files changed" << std::endl;
+  }
+
+  auto start = clock::now();
+  Compiler compiler(createPackage(), unit, jobs);
   compiler.parse();
-  compiler.gen(translate);
+  if (verbose) {
+    std::cerr << "transpile: parse " << elapsed(start) << " ms" << std::endl;
+  }
+  start = clock::now();
+  compiler.infer(verbose ? &std::cerr : nullptr);
+  if (verbose) {
+    std::cerr << "transpile: infer " << elapsed(start) << " ms" << std::endl;
+  }
+  start = clock::now();
+  compiler.gen(translate, instantiate, executable || staticExecutable);
+  if (verbose) {
+    std::cerr << "transpile: generate " << elapsed(start) << " ms" <<
+        std::endl;
+  }
+
+  /* written last, so that an interrupted transpile is redone */
+  write_all(manifestPath, contents);
+}
+
+std::string birch::Driver::manifest() {
+  std::stringstream buf;
+
+  /* development builds of the driver are all unversioned, so a hash of its
+   * executable stands in for a version, to invalidate the manifest when any
+   * part of the driver changes */
+  auto exe = executable_path();
+  buf << "driver " << PACKAGE_VERSION << ' ';
+  if (exe.empty()) {
+    /* cannot tell whether the driver has changed, so never match */
+    buf << "unknown " <<
+        std::chrono::system_clock::now().time_since_epoch().count();
+  } else {
+    buf << std::hash<std::string>()(read_all(exe));
+  }
+  buf << '\n';
+  buf << "package " << packageName << '\n';
+  for (auto value : metaContents["require.package"]) {
+    buf << "require " << value << '\n';
+  }
+  buf << "unit " << unit;
+  if (unit == "balanced") {
+    buf << ' ' << units();
+  }
+  buf << '\n';
+  buf << "translate " << translate << '\n';
+  buf << "instantiate " << instantiate << '\n';
+  buf << "executable " << (executable || staticExecutable) << '\n';
+  for (auto file : sources()) {
+    buf << file.string() << '\t' <<
+        std::hash<std::string>()(read_all(file)) << '\n';
+  }
+  return buf.str();
+}
+
+int birch::Driver::units() {
+  return Compiler::units(jobs, sources().size());
+}
+
+std::list<fs::path> birch::Driver::sources() {
+  std::list<fs::path> files;
+  for (auto file : metaFiles["manifest.source"]) {
+    if (file.extension().compare(".birch") == 0) {
+      files.push_back(file);
+    }
+  }
+  return files;
 }
 
 void birch::Driver::target(const std::string& cmd) {
@@ -1166,6 +1476,21 @@ void birch::Driver::target(const std::string& cmd) {
     buf << " -j " << jobs;
   }
 
+  /* link-time and profile-guided optimization, see share/Makefile.am */
+  if (!lto) {
+    buf << " LTO_CXXFLAGS=";
+  }
+  if (!pgoMode.empty()) {
+    auto profile = fs::absolute(fs::path("build") / "pgo");
+    if (pgoMode == "generate") {
+      buf << " PGO_CXXFLAGS=\"-fprofile-generate=" << profile.string() <<
+          " -fprofile-update=prefer-atomic\"";
+    } else {
+      buf << " PGO_CXXFLAGS=\"-fprofile-use=" << profile.string() <<
+          " -fprofile-correction\"";
+    }
+  }
+
   /* target */
   buf << ' ' << cmd << " 2>&1";  // stderr to stdout so pipe has both
 
@@ -1310,10 +1635,8 @@ birch::Package* birch::Driver::createPackage() {
   for (auto value : metaContents["require.package"]) {
     package->addPackage(value);
   }
-  for (auto file : metaFiles["manifest.source"]) {
-    if (file.extension().compare(".birch") == 0) {
-      package->addSource(file.string());
-    }
+  for (auto file : sources()) {
+    package->addSource(file.string());
   }
   return package;
 }
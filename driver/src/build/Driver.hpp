@@ -62,6 +62,12 @@ public:
    */
   void clean();
 
+  /**
+   * Build package with profile-guided optimization: build instrumented, run
+   * a program to collect a profile, then rebuild using the profile.
+   */
+  void pgo();
+
   /**
    * Create a new package.
    */
@@ -94,10 +100,30 @@ private:
   void setup();
 
   /**
-   * Transpile Birch files to C++.
+   * Transpile Birch files to C++. This is skipped if the source files and
+   * options are unchanged since the last transpile, see manifest().
    */
   void transpile();
 
+  /**
+   * Manifest of the inputs to transpile(): the driver version and a hash of
+   * its executable, options that affect the generated code, and the path
+   * and a hash of the contents of each source file, one per line.
+   */
+  std::string manifest();
+
+  /**
+   * Number of compile units when `unit` is `balanced`, see
+   * Compiler::units().
+   */
+  int units();
+
+  /**
+   * Birch source files of the package, from which it is created by
+   * createPackage(), in the same order.
+   */
+  std::list<fs::path> sources();
+
   /**
    * Run make with a given target.
    *
@@ -143,7 +169,7 @@ private:
   std::string arch;
 
   /**
-   * Compilation unit ("unity", "dir", or "file").
+   * Compilation unit ("unity", "dir", "file", or "balanced").
    */
   std::string unit;
 
@@ -152,6 +178,12 @@ private:
    */
   std::string mode;
 
+  /**
+   * Thread binding when running a program ("close", "spread", or empty for
+   * none).
+   */
+  std::string bind;
+
   /**
    * Number of jobs for parallel build. If zero, a reasonable value is
    * determined from the environment.
@@ -188,6 +220,36 @@ private:
    */
   bool openmp;
 
+  /**
+   * Profile-guided optimization ("generate", "use", or empty for none).
+   */
+  std::string pgoMode;
+
+  /**
+   * Enable link-time optimization?
+   */
+  bool lto;
+
+  /**
+   * Enable precompiled package header?
+   */
+  bool precompile;
+
+  /**
+   * Enable explicit instantiation of generic classes?
+   */
+  bool instantiate;
+
+  /**
+   * Enable standalone executable?
+   */
+  bool executable;
+
+  /**
+   * Enable fully static standalone executable?
+   */
+  bool staticExecutable;
+
   /**
    * Enable compiler warnings?
    */
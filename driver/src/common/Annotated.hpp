@@ -46,7 +46,13 @@ enum Annotation {
   /**
    * Struct, rather than class (implies FINAL).
    */
-  STRUCT = 64|16
+  STRUCT = 64|16,
+
+  /**
+   * Local variable of class type that does not escape, and so may be
+   * allocated inplace rather than on the heap (inferred, not written).
+   */
+  INPLACE = 128
 };
 
 /**
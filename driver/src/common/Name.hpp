@@ -66,8 +66,9 @@ private:
   std::string name;
 
   /**
-   * Counter for unique names.
+   * Counter for unique names. This is thread local, as files are parsed
+   * concurrently; names need only be unique within a file.
    */
-  static int COUNTER;
+  static thread_local int COUNTER;
 };
 }
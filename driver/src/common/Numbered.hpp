@@ -21,8 +21,8 @@ public:
 
 private:
   /**
-   * Counter.
+   * Counter. This is thread local, as files are parsed concurrently.
    */
-  static int COUNTER;
+  static thread_local int COUNTER;
 };
 }
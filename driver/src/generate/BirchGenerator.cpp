@@ -473,7 +473,11 @@ void birch::BirchGenerator::visit(const ArrayType* o) {
     if (i > 0) {
       middle(',');
     }
-    middle('_');
+    if (o->isFixed()) {
+      middle('_' << o->lengths[i]);
+    } else {
+      middle('_');
+    }
   }
   middle(']');
 }
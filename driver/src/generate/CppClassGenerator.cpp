@@ -158,6 +158,53 @@ void birch::CppClassGenerator::visit(const Class* o) {
       line("}\n");
     }
 
+    /* deserialization constructor, reads member variables in the same order
+     * as they are listed by LIBBIRCH_CLASS_MEMBERS */
+    if (!header) {
+      genTemplateParams(o);
+      genSourceLine(o->loc);
+      start(o->name << '_');
+      genTemplateArgs(o);
+      middle("::");
+    } else {
+      genSourceLine(o->loc);
+      start("");
+    }
+    middle(o->name << "_(libbirch::Deserializer& visitor_)");
+    if (header) {
+      finish(";\n");
+    } else {
+      bool first = o->has(STRUCT);
+      if (!o->has(STRUCT)) {
+        finish(" :");
+        in();
+        in();
+        genSourceLine(o->loc);
+        start("base_type_(visitor_)");
+      }
+      for (auto o : memberVariables) {
+        if (first) {
+          finish(" :");
+          in();
+          in();
+        } else {
+          finish(',');
+        }
+        first = false;
+        genSourceLine(o->loc);
+        start(o->name << "(visitor_.read<" << o->type << ">())");
+      }
+      if (!first) {
+        out();
+        out();
+      }
+      finish(" {");
+      in();
+      line("//");
+      out();
+      line("}\n");
+    }
+
     /* member variables and functions */
     *this << o->braces->strip();
 
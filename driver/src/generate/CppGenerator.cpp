@@ -178,6 +178,14 @@ void birch::CppGenerator::visit(const Member* o) {
     middle("this->base_type_::");
   } else {
     middle(o->left << "->");
+    auto named = dynamic_cast<const NamedExpression*>(o->left);
+    if (named && !named->type->isEmpty()) {
+      /* the dynamic type is known exactly, see ExactInferrer, so qualify the
+       * member to avoid virtual dispatch */
+      auto type = dynamic_cast<const NamedType*>(named->type);
+      assert(type);
+      middle(type->name << "_::");
+    }
   }
   ++inMember;
   middle(o->right);
@@ -254,6 +262,10 @@ void birch::CppGenerator::visit(const MemberVariable* o) {
 void birch::CppGenerator::visit(const LocalVariable* o) {
   if (o->has(LET)) {
     start("auto " << o->name);
+  } else if (o->has(INPLACE)) {
+    /* does not escape, so allocate on the stack, see InplaceInferrer */
+    start("libbirch::Inplace<typename libbirch::unwrap_pointer<" << o->type <<
+        ">::type> " << o->name);
   } else {
     start(o->type << ' ' << o->name);
   }
@@ -262,7 +274,12 @@ void birch::CppGenerator::visit(const LocalVariable* o) {
 }
 
 void birch::CppGenerator::visit(const TupleVariable* o) {
-  Name* tmp = new Name();
+  /* name the temporary after the first element, which is unique in scope;
+   * a counter would make the output depend on the order in which files are
+   * generated */
+  auto first = dynamic_cast<const LocalVariable*>(*o->locals->begin());
+  assert(first);
+  Name* tmp = new Name(first->name->str() + "_tuple_");
   int i = 0;
   line("auto " << tmp << " = " << o->value << ';');
   for (auto iter = o->locals->begin(); iter != o->locals->end(); ++iter) {
@@ -574,24 +591,16 @@ void birch::CppGenerator::visit(const For* o) {
 void birch::CppGenerator::visit(const Parallel* o) {
   auto index = genIndex(o->index);
   genSourceLine(o->loc);
-  line("#pragma omp parallel");
-  line("{");
-  in();
-  start("#pragma omp for schedule(");
-  if (o->has(DYNAMIC)) {
-    middle("guided");
-  } else {
-    middle("static");
-  }
-  finish(')');
-  start("for (auto " << index << " = " << o->from << "; ");
-  finish(index << " <= " << o->to << "; ++" << index << ") {");
+  start("libbirch::parallel_for(" << o->from << ", " << o->to << ", ");
+  finish("[&](const Integer " << index << ") {");
   in();
   *this << o->braces->strip();
   out();
-  line("}");
-  out();
-  line("}");
+  start("}");
+  if (o->has(DYNAMIC)) {
+    middle(", true");
+  }
+  finish(");");
 }
 
 void birch::CppGenerator::visit(const While* o) {
@@ -654,7 +663,15 @@ void birch::CppGenerator::visit(const EmptyType* o) {
 }
 
 void birch::CppGenerator::visit(const ArrayType* o) {
-  middle("libbirch::DefaultArray<" << o->single << ',' << o->depth() << '>');
+  if (o->isFixed()) {
+    middle("libbirch::FixedArray<" << o->single);
+    for (auto length : o->lengths) {
+      middle(',' << length);
+    }
+    middle('>');
+  } else {
+    middle("libbirch::DefaultArray<" << o->single << ',' << o->depth() << '>');
+  }
 }
 
 void birch::CppGenerator::visit(const TupleType* o) {
@@ -0,0 +1,68 @@
+/**
+ * @file
+ */
+#include "src/generate/CppMainGenerator.hpp"
+
+#include "src/visitor/Gatherer.hpp"
+
+birch::CppMainGenerator::CppMainGenerator(std::ostream& base) :
+    CppGenerator(base, 0, false, false, false) {
+  //
+}
+
+void birch::CppMainGenerator::visit(const Package* o) {
+  /* programs with a body; those without are implemented by the driver */
+  Gatherer<Program> programs([](const Program* o) {
+        return !o->braces->isEmpty();
+      }, false);
+  o->accept(&programs);
+
+  line("#include <cstdio>");
+  line("#include <cstdlib>");
+  line("#include <cstring>");
+  line("#include <dlfcn.h>\n");
+
+  line("int main(int argc, char** argv) {");
+  in();
+
+  /* program named by the executable */
+  line("const char* name = std::strrchr(argv[0], '/');");
+  line("name = name ? name + 1 : argv[0];");
+  for (auto o : programs) {
+    line("if (std::strcmp(name, \"" << o->name->str() << "\") == 0) {");
+    in();
+    line("return birch::" << o->name << "(argc, argv);");
+    out();
+    line("}");
+  }
+  line("");
+
+  /* program named by the first argument */
+  line("if (argc < 2) {");
+  in();
+  line("std::fprintf(stderr, \"Usage: %s <program> [options...]\\n\", argv[0]);");
+  line("return EXIT_FAILURE;");
+  out();
+  line("}");
+  for (auto o : programs) {
+    line("if (std::strcmp(argv[1], \"" << o->name->str() << "\") == 0) {");
+    in();
+    line("return birch::" << o->name << "(argc - 1, argv + 1);");
+    out();
+    line("}");
+  }
+  line("");
+
+  /* program of a library linked to, already loaded, so no dlopen() */
+  line("typedef int prog_t(int argc, char** argv);");
+  line("auto prog = reinterpret_cast<prog_t*>(dlsym(RTLD_DEFAULT, argv[1]));");
+  line("if (prog) {");
+  in();
+  line("return prog(argc - 1, argv + 1);");
+  out();
+  line("}");
+  line("std::fprintf(stderr, \"Could not find program %s.\\n\", argv[1]);");
+  line("return EXIT_FAILURE;");
+  out();
+  line("}");
+}
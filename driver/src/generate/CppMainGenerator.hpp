@@ -0,0 +1,34 @@
+/**
+ * @file
+ */
+#pragma once
+
+#include "src/generate/CppGenerator.hpp"
+
+namespace birch {
+/**
+ * C++ code generator for the main function of a standalone executable for
+ * the programs of a package.
+ *
+ * The executable runs the program named by its own file name (e.g. a link
+ * to it named after the program), or otherwise by its first argument, with
+ * the remaining arguments, just as `birch <program> [options...]` does. A
+ * program not found in the package is looked up among those of the
+ * libraries linked to, such as dependencies.
+ *
+ * @ingroup driver
+ */
+class CppMainGenerator: public CppGenerator {
+public:
+  /**
+   * Constructor.
+   *
+   * @param base Base stream.
+   */
+  CppMainGenerator(std::ostream& base);
+
+  using CppGenerator::visit;
+
+  virtual void visit(const Package* o);
+};
+}
@@ -5,6 +5,7 @@
 
 #include "src/generate/CppClassGenerator.hpp"
 #include "src/visitor/Gatherer.hpp"
+#include "src/visitor/InstantiationGatherer.hpp"
 #include "src/primitive/poset.hpp"
 #include "src/primitive/inherits.hpp"
 #include "src/primitive/string.hpp"
@@ -12,8 +13,9 @@
 
 birch::CppPackageGenerator::CppPackageGenerator(std::ostream& base,
     const int level, const bool header, const bool includeInlines,
-    const bool includeLines) :
-    CppGenerator(base, level, header, includeInlines, includeLines) {
+    const bool includeLines, const bool instantiate) :
+    CppGenerator(base, level, header, includeInlines, includeLines),
+    instantiate(instantiate) {
   //
 }
 
@@ -47,6 +49,16 @@ void birch::CppPackageGenerator::visit(const Package* o) {
     sortedClasses.insert(o);
   }
 
+  /* instantiations of generic classes to explicitly instantiate */
+  InstantiationGatherer instantiations;
+  if (instantiate) {
+    o->accept(&instantiations);
+  }
+  std::unordered_map<std::string,const Class*> generics;
+  for (auto o : classes) {
+    generics.insert(std::make_pair(o->name->str(), o));
+  }
+
   if (header) {
     /* don't use #pragma once here, use a macro guard instead, as the header
      * may be used as a source file to create a pre-compiled header */
@@ -205,7 +217,32 @@ void birch::CppPackageGenerator::visit(const Package* o) {
         auxDefinition << o;
       }
     }
+
+    /* explicit instantiation declarations, so that these are not
+     * instantiated implicitly by each compile unit that uses them, here or
+     * in dependent packages */
+    if (instantiations.size() > 0) {
+      line("");
+      for (auto o : instantiations) {
+        if (generics[o->name->str()]->has(STRUCT)) {
+          line("extern template struct " << o->name << "_<" << o->typeArgs << ">;");
+        } else {
+          line("extern template class " << o->name << "_<" << o->typeArgs << ">;");
+        }
+      }
+    }
     line("}\n");  // close namespace
     line("#endif");
+  } else if (instantiations.size() > 0) {
+    /* explicit instantiation definitions */
+    line("namespace birch {");
+    for (auto o : instantiations) {
+      if (generics[o->name->str()]->has(STRUCT)) {
+        line("template struct " << o->name << "_<" << o->typeArgs << ">;");
+      } else {
+        line("template class " << o->name << "_<" << o->typeArgs << ">;");
+      }
+    }
+    line("}\n");
   }
 }
@@ -13,11 +13,30 @@ namespace birch {
  */
 class CppPackageGenerator: public CppGenerator {
 public:
+  /**
+   * Constructor.
+   *
+   * @param base Base stream.
+   * @param level Indentation level.
+   * @param header Generate the header (or, for a source file, the explicit
+   * instantiations, if any)?
+   * @param includeInline Include inline code?
+   * @param includeLines Include #line annotations?
+   * @param instantiate Explicitly instantiate the generic classes of the
+   * package that are used by the package, see InstantiationGatherer?
+   */
   CppPackageGenerator(std::ostream& base, const int level, const bool header,
-      const bool includeInline, const bool includeLines);
+      const bool includeInline, const bool includeLines,
+      const bool instantiate = false);
 
   using CppGenerator::visit;
 
   virtual void visit(const Package* o);
+
+private:
+  /**
+   * Explicitly instantiate generic classes?
+   */
+  bool instantiate;
 };
 }
@@ -476,7 +476,11 @@ void birch::MarkdownGenerator::visit(const ArrayType* o) {
     if (i > 0) {
       middle(',');
     }
-    middle("\\_");
+    if (o->isFixed()) {
+      middle("\\_" << o->lengths[i]);
+    } else {
+      middle("\\_");
+    }
   }
   middle(']');
 }
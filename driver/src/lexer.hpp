@@ -5,17 +5,61 @@
  */
 #pragma once
 
-extern FILE* yyin;
-extern char *yytext;
-extern std::stringstream raw;
-extern int yylineno;
-
-int yylex();
-int yyparse();
-void yyerror(const char *);
-void yywarn(const char *);
-void yylocation();
-void yycount();
-void yyreset();
-void yyrestart(FILE*);
-int yylex_destroy();
+namespace birch {
+class File;
+
+/**
+ * State of the lexer and parser for one file. The lexer is reentrant and the
+ * parser pure, so that with a separate state for each, files can be parsed
+ * concurrently.
+ */
+struct ParserState {
+  /**
+   * Constructor.
+   *
+   * @param file The file being parsed.
+   */
+  ParserState(File* file) :
+      file(file),
+      line(1),
+      col(1) {
+    //
+  }
+
+  /**
+   * The file being parsed.
+   */
+  File* file;
+
+  /**
+   * Raw string (documentation comment or C++ code) currently being read.
+   */
+  std::stringstream raw;
+
+  /**
+   * Stack of raw strings awaiting the declarations to which they belong.
+   */
+  std::stack<std::string> raws;
+
+  /**
+   * Current line number.
+   */
+  int line;
+
+  /**
+   * Current column number.
+   */
+  int col;
+};
+}
+
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void* yyscan_t;
+#endif
+
+int yylex_init_extra(birch::ParserState* state, yyscan_t* scanner);
+int yylex_destroy(yyscan_t scanner);
+void yyset_in(FILE* in, yyscan_t scanner);
+birch::ParserState* yyget_extra(yyscan_t scanner);
+int yyparse(yyscan_t scanner);
@@ -4,60 +4,39 @@
 #include "src/primitive/string.hpp"
 
 bool birch::isTranslatable(const std::string& op) {
-  static std::unordered_set<std::string> ops;
-  static bool init = false;
-  if (!init) {
-    ops.insert("+");
-    ops.insert("-");
-    ops.insert("*");
-    ops.insert("/");
-    ops.insert("<");
-    ops.insert(">");
-    ops.insert("<=");
-    ops.insert(">=");
-    ops.insert("==");
-    ops.insert("!=");
-    ops.insert("!");
-    ops.insert("||");
-    ops.insert("&&");
-
-    init = true;
-  }
+  static const std::unordered_set<std::string> ops = { "+", "-", "*", "/",
+      "<", ">", "<=", ">=", "==", "!=", "!", "||", "&&" };
   return ops.find(op) != ops.end();
 }
 
 std::string birch::nice(const std::string& name) {
   /* translations */
-  static std::regex reg;
-  static std::unordered_map<std::string,std::string> ops;
-  static bool init = false;
-  if (!init) {
-    ops["<-"] = "assign_";
-    ops["<~"] = "left_tilde_";
-    ops["~>"] = "right_tilde_";
-    ops["~"] = "tilde_";
-    ops[".."] = "range_";
-    ops["+"] = "add_";
-    ops["-"] = "subtract_";
-    ops["*"] = "multiply_";
-    ops["/"] = "divide_";
-    ops["<"] = "lt_";
-    ops[">"] = "gt_";
-    ops["<="] = "le_";
-    ops[">="] = "ge_";
-    ops["=="] = "eq_";
-    ops["!="] = "ne_";
-    ops["!"] = "not_";
-    ops["||"] = "or_";
-    ops["&&"] = "and_";
-
-    init = true;
-  }
+  static const std::unordered_map<std::string,std::string> ops = {
+    { "<-", "assign_" },
+    { "<~", "left_tilde_" },
+    { "~>", "right_tilde_" },
+    { "~", "tilde_" },
+    { "..", "range_" },
+    { "+", "add_" },
+    { "-", "subtract_" },
+    { "*", "multiply_" },
+    { "/", "divide_" },
+    { "<", "lt_" },
+    { ">", "gt_" },
+    { "<=", "le_" },
+    { ">=", "ge_" },
+    { "==", "eq_" },
+    { "!=", "ne_" },
+    { "!", "not_" },
+    { "||", "or_" },
+    { "&&", "and_" }
+  };
 
   /* translate operators */
   std::string str = name;
-  if (ops.find(name) != ops.end()) {
-    str = ops[name];
+  auto iter = ops.find(name);
+  if (iter != ops.end()) {
+    str = iter->second;
   }
 
   /* translate prime (apostrophe at end of name) */
@@ -7,6 +7,12 @@
 #include "src/statement/File.hpp"
 #include "src/exception/DriverException.hpp"
 
+#ifdef __APPLE__
+#include <mach-o/dyld.h>
+#else
+#include <unistd.h>
+#endif
+
 void birch::warn(const std::string& msg) {
   std::cerr << "warning: " << msg << std::endl;
 }
@@ -131,6 +137,28 @@ fs::path birch::remove_common_prefix(const fs::path& base, const fs::path& path)
   }
 }
 
+fs::path birch::executable_path() {
+  #ifdef __APPLE__
+  uint32_t size = 0;
+  _NSGetExecutablePath(nullptr, &size);
+  std::vector<char> buf(size);
+  if (_NSGetExecutablePath(buf.data(), &size) == 0) {
+    return fs::path(buf.data());
+  }
+  #else
+  /* Linux provides /proc/self/exe, FreeBSD /proc/curproc/file where procfs
+   * is mounted */
+  for (auto link : {"/proc/self/exe", "/proc/curproc/file"}) {
+    std::vector<char> buf(4096);
+    auto size = readlink(link, buf.data(), buf.size() - 1);
+    if (size > 0) {
+      return fs::path(std::string(buf.data(), size));
+    }
+  }
+  #endif
+  return fs::path();
+}
+
 std::string birch::read_all(const fs::path& path) {
   fs_stream::ifstream in(path);
   std::stringstream buf;
@@ -82,6 +82,12 @@ fs::path remove_first(const fs::path& path);
  */
 fs::path remove_common_prefix(const fs::path& base, const fs::path& path);
 
+/**
+ * Path of the running executable, or an empty path if it cannot be
+ * determined.
+ */
+fs::path executable_path();
+
 /**
  * Read the entirety of a file to a string.
  */
@@ -13,6 +13,15 @@ birch::ArrayType::ArrayType(Type* single, const int ndims,
   //
 }
 
+birch::ArrayType::ArrayType(Type* single, const std::vector<int64_t>& lengths,
+    Location* loc) :
+    Type(loc),
+    Single<Type>(single),
+    ndims(int(lengths.size())),
+    lengths(lengths) {
+  //
+}
+
 void birch::ArrayType::accept(Visitor* visitor) const {
   return visitor->visit(this);
 }
@@ -25,6 +34,10 @@ bool birch::ArrayType::isArray() const {
   return true;
 }
 
+bool birch::ArrayType::isFixed() const {
+  return !lengths.empty();
+}
+
 birch::Type* birch::ArrayType::element() {
   return single->element();
 }
@@ -23,6 +23,17 @@ public:
    */
   ArrayType(Type* single, const int ndims, Location* loc = nullptr);
 
+  /**
+   * Constructor for a fixed array type, written with each length after an
+   * underscore, e.g. `Real[_3]` or `Real[_2,_3]`.
+   *
+   * @param single Type.
+   * @param lengths Length of each dimension.
+   * @param loc Location.
+   */
+  ArrayType(Type* single, const std::vector<int64_t>& lengths,
+      Location* loc = nullptr);
+
   virtual void accept(Visitor* visitor) const;
 
   virtual int depth() const;
@@ -30,9 +41,19 @@ public:
   virtual const Type* element() const;
   virtual bool isArray() const;
 
+  /**
+   * Is this a fixed array type, with lengths given in the type?
+   */
+  bool isFixed() const;
+
   /**
    * Number of dimensions.
    */
   int ndims;
+
+  /**
+   * Length of each dimension, for a fixed array type, otherwise empty.
+   */
+  std::vector<int64_t> lengths;
 };
 }
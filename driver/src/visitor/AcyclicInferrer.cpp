@@ -0,0 +1,195 @@
+/**
+ * @file
+ */
+#include "src/visitor/AcyclicInferrer.hpp"
+
+#include "src/visitor/Gatherer.hpp"
+
+birch::AcyclicInferrer::AcyclicInferrer(std::ostream* report) :
+    report(report) {
+  //
+}
+
+void birch::AcyclicInferrer::visit(const Package* o) {
+  Gatherer<Class> gatherer(
+      [](const Class* o) -> bool {
+        return true;
+      }, false);
+  o->accept(&gatherer);
+  for (auto o : gatherer) {
+    classes.insert(std::make_pair(o->name->str(), o));
+  }
+
+  /* classes in order of name, for a reproducible report */
+  std::map<std::string,Class*> sorted;
+  for (auto o : gatherer) {
+    sorted.insert(std::make_pair(o->name->str(), o));
+  }
+  for (auto pair : sorted) {
+    auto o = pair.second;
+    if (!o->has(STRUCT) && !o->isAlias() && !o->braces->isEmpty()) {
+      if (o->has(ABSTRACT)) {
+        //
+      } else if (o->has(ACYCLIC)) {
+        if (report) {
+          *report << "acyclic: " << o->name->str() << " (annotated)" << std::endl;
+        }
+      } else {
+        std::string reason;
+        if (isAcyclic(o, Scope(), reason)) {
+          o->set(ACYCLIC);
+          if (report) {
+            *report << "acyclic: " << o->name->str() << std::endl;
+          }
+        } else if (report) {
+          *report << "not acyclic: " << o->name->str() << ", " << reason <<
+              std::endl;
+        }
+      }
+    }
+  }
+}
+
+bool birch::AcyclicInferrer::isAcyclic(const Class* o, const Scope& scope,
+    std::string& reason) {
+  /* memoize only where the result cannot depend on type arguments */
+  bool unbound = std::all_of(scope.bindings.begin(), scope.bindings.end(),
+      [](const std::pair<std::string,Binding>& pair) -> bool {
+        return pair.second.type == nullptr;
+      });
+  if (unbound) {
+    auto iter = memo.find(o);
+    if (iter != memo.end()) {
+      reason = iter->second;
+      return reason.empty();
+    }
+  }
+  if (!visiting.insert(o).second) {
+    reason = "as it is recursive";
+    return false;
+  }
+
+  bool result = true;
+  Scope inner = scope;
+  for (auto param : *o->typeParams) {
+    auto generic = dynamic_cast<const Generic*>(param);
+    assert(generic);
+    inner.bindings.insert(std::make_pair(generic->name->str(),
+        Binding{nullptr, nullptr}));
+  }
+
+  /* raw C++ declarations may introduce any member variable */
+  Gatherer<Raw> raws([](const Raw* o) -> bool {
+        return *o->name == "hpp";
+      });
+  o->braces->accept(&raws);
+  if (raws.size() > 0) {
+    reason = "as it contains raw C++ declarations";
+    result = false;
+  }
+
+  /* base class */
+  auto base = dynamic_cast<const NamedType*>(o->base);
+  if (result && base && base->name->str() != "Object") {
+    auto iter = classes.find(base->name->str());
+    if (iter == classes.end()) {
+      reason = "as its base " + base->name->str() +
+          " is not in this package";
+      result = false;
+    } else {
+      result = isAcyclic(iter->second, bind(iter->second, base->typeArgs,
+          inner), reason);
+    }
+  }
+
+  /* member variables */
+  Gatherer<MemberVariable> members;
+  o->braces->accept(&members);
+  for (auto iter = members.begin(); result && iter != members.end();
+      ++iter) {
+    std::string why;
+    if (!isAcyclic((*iter)->type, inner, why)) {
+      reason = "as member " + (*iter)->name->str() + " " + why;
+      result = false;
+    }
+  }
+
+  visiting.erase(o);
+  if (unbound) {
+    memo.insert(std::make_pair(o, result ? std::string() : reason));
+  }
+  return result;
+}
+
+bool birch::AcyclicInferrer::isAcyclic(const Type* o, const Scope& scope,
+    std::string& reason) {
+  if (o->isEmpty()) {
+    return true;
+  } else if (o->isArray() || o->isOptional() || o->isTuple()) {
+    auto single = dynamic_cast<const Single<Type>*>(o);
+    assert(single);
+    return isAcyclic(single->single, scope, reason);
+  } else if (auto list = dynamic_cast<const TypeList*>(o)) {
+    return isAcyclic(list->head, scope, reason) &&
+        isAcyclic(list->tail, scope, reason);
+  } else if (auto named = dynamic_cast<const NamedType*>(o)) {
+    auto name = named->name->str();
+    auto binding = scope.bindings.find(name);
+    if (binding != scope.bindings.end()) {
+      /* generic type parameter */
+      if (binding->second.type) {
+        return isAcyclic(binding->second.type, *binding->second.scope,
+            reason);
+      } else {
+        reason = "has generic type " + name;
+        return false;
+      }
+    }
+    static const std::unordered_set<std::string> basics = { "Boolean",
+        "Integer", "Real", "String", "File" };
+    if (basics.find(name) != basics.end()) {
+      return true;
+    }
+    auto iter = classes.find(name);
+    if (iter == classes.end()) {
+      reason = "has type " + name + ", which is not in this package";
+      return false;
+    }
+    auto c = iter->second;
+    if (c->isAlias()) {
+      return isAcyclic(c->base, bind(c, named->typeArgs, scope), reason);
+    } else if (!c->has(FINAL)) {
+      reason = "has type " + name + ", which is not final";
+      return false;
+    } else {
+      std::string why;
+      if (!isAcyclic(c, bind(c, named->typeArgs, scope), why)) {
+        reason = "has type " + name + ", which is not acyclic";
+        return false;
+      }
+      return true;
+    }
+  } else {
+    reason = "has a deduced or member type";
+    return false;
+  }
+}
+
+birch::AcyclicInferrer::Scope birch::AcyclicInferrer::bind(const Class* o,
+    const Type* typeArgs, const Scope& scope) {
+  Scope result;
+  auto arg = typeArgs->begin();
+  for (auto param : *o->typeParams) {
+    auto generic = dynamic_cast<const Generic*>(param);
+    assert(generic);
+    if (arg != typeArgs->end()) {
+      result.bindings.insert(std::make_pair(generic->name->str(),
+          Binding{*arg, &scope}));
+      ++arg;
+    } else {
+      result.bindings.insert(std::make_pair(generic->name->str(),
+          Binding{nullptr, nullptr}));
+    }
+  }
+  return result;
+}
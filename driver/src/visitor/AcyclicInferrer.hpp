@@ -0,0 +1,116 @@
+/**
+ * @file
+ */
+#pragma once
+
+#include "src/visitor/Visitor.hpp"
+
+namespace birch {
+/**
+ * Infers which classes of a package are acyclic, i.e. whose objects cannot
+ * participate in a reference cycle, and annotates them as such. This allows
+ * the generated code to use the cheaper reference counting of acyclic
+ * objects without annotating classes by hand.
+ *
+ * A class is inferred acyclic if it is neither abstract nor a struct, and
+ * each of its member variables, including those of its base classes, has a
+ * type that is one of:
+ *
+ *   - a basic value type (`Boolean`, `Integer`, `Real`, `String`, `File`),
+ *   - a struct of the package, all of whose member variables also satisfy
+ *     these conditions,
+ *   - a `final` class of the package that is itself acyclic, or
+ *   - an array, optional or tuple of any of these.
+ *
+ * Generic type parameters, types from other packages, non-final classes
+ * (which may have subclasses elsewhere that reference back) and classes with
+ * raw C++ declarations cannot be proven acyclic. Recursive types, such as a
+ * final class with a member of its own type, are not acyclic.
+ *
+ * @ingroup visitor
+ */
+class AcyclicInferrer: public Visitor {
+public:
+  /**
+   * Constructor.
+   *
+   * @param report Output stream for a report of the classes that were
+   * inferred acyclic, and the reason for each that was not, or `nullptr` for
+   * no report.
+   */
+  AcyclicInferrer(std::ostream* report = nullptr);
+
+  using Visitor::visit;
+  virtual void visit(const Package* o);
+
+private:
+  struct Scope;
+
+  /**
+   * Binding of a generic type parameter to a type argument, along with the
+   * scope in which that argument is to be resolved. An unbound parameter
+   * has a null type.
+   */
+  struct Binding {
+    const Type* type;
+    const Scope* scope;
+  };
+
+  /**
+   * Bindings of the generic type parameters of a class.
+   */
+  struct Scope {
+    std::unordered_map<std::string,Binding> bindings;
+  };
+
+  /**
+   * Is a class, with the given bindings of its generic type parameters,
+   * acyclic?
+   *
+   * @param o The class.
+   * @param scope Bindings of its generic type parameters.
+   * @param[out] reason If not acyclic, the reason.
+   */
+  bool isAcyclic(const Class* o, const Scope& scope, std::string& reason);
+
+  /**
+   * Is a member variable type acyclic?
+   *
+   * @param o The type.
+   * @param scope Scope in which to resolve generic type parameters.
+   * @param[out] reason If not acyclic, the reason.
+   */
+  bool isAcyclic(const Type* o, const Scope& scope, std::string& reason);
+
+  /**
+   * Bind the generic type parameters of a class to type arguments.
+   *
+   * @param o The class.
+   * @param typeArgs The type arguments.
+   * @param scope Scope in which to resolve the type arguments.
+   */
+  static Scope bind(const Class* o, const Type* typeArgs, const Scope& scope);
+
+  /**
+   * Output stream for report.
+   */
+  std::ostream* report;
+
+  /**
+   * Classes of the package, by name.
+   */
+  std::unordered_map<std::string,const Class*> classes;
+
+  /**
+   * Classes for which acyclicity is being determined, to detect recursive
+   * types.
+   */
+  std::unordered_set<const Class*> visiting;
+
+  /**
+   * Memoized results for classes without bound type parameters, with the
+   * reason when not acyclic (empty when acyclic).
+   */
+  std::unordered_map<const Class*,std::string> memo;
+};
+}
@@ -0,0 +1,95 @@
+/**
+ * @file
+ */
+#include "src/visitor/CostEstimator.hpp"
+
+birch::CostEstimator::CostEstimator() :
+    total(0) {
+  //
+}
+
+size_t birch::CostEstimator::cost() const {
+  return total;
+}
+
+void birch::CostEstimator::visit(const Class* o) {
+  if (!o->isGeneric()) {
+    total += CLASS_COST;
+    Visitor::visit(o);
+  }
+}
+
+void birch::CostEstimator::visit(const Function* o) {
+  if (!o->isGeneric()) {
+    total += FUNCTION_COST;
+    Visitor::visit(o);
+  }
+}
+
+void birch::CostEstimator::visit(const Program* o) {
+  total += FUNCTION_COST;
+  Visitor::visit(o);
+}
+
+void birch::CostEstimator::visit(const MemberFunction* o) {
+  total += FUNCTION_COST;
+  Visitor::visit(o);
+}
+
+void birch::CostEstimator::visit(const BinaryOperator* o) {
+  if (!o->isGeneric()) {
+    total += FUNCTION_COST;
+    Visitor::visit(o);
+  }
+}
+
+void birch::CostEstimator::visit(const UnaryOperator* o) {
+  if (!o->isGeneric()) {
+    total += FUNCTION_COST;
+    Visitor::visit(o);
+  }
+}
+
+void birch::CostEstimator::visit(const AssignmentOperator* o) {
+  total += FUNCTION_COST;
+  Visitor::visit(o);
+}
+
+void birch::CostEstimator::visit(const ConversionOperator* o) {
+  total += FUNCTION_COST;
+  Visitor::visit(o);
+}
+
+void birch::CostEstimator::visit(const SliceOperator* o) {
+  total += FUNCTION_COST;
+  Visitor::visit(o);
+}
+
+void birch::CostEstimator::visit(const Call* o) {
+  total += CALL_COST;
+  Visitor::visit(o);
+}
+
+void birch::CostEstimator::visit(const BinaryCall* o) {
+  total += CALL_COST;
+  Visitor::visit(o);
+}
+
+void birch::CostEstimator::visit(const UnaryCall* o) {
+  total += CALL_COST;
+  Visitor::visit(o);
+}
+
+void birch::CostEstimator::visit(const NamedExpression* o) {
+  if (!o->typeArgs->isEmpty()) {
+    total += GENERIC_COST;
+  }
+  Visitor::visit(o);
+}
+
+void birch::CostEstimator::visit(const NamedType* o) {
+  if (!o->typeArgs->isEmpty()) {
+    total += GENERIC_COST;
+  }
+  Visitor::visit(o);
+}
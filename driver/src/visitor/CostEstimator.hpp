@@ -0,0 +1,76 @@
+/**
+ * @file
+ */
+#pragma once
+
+#include "src/visitor/Visitor.hpp"
+
+namespace birch {
+/**
+ * Estimates the cost of compiling the C++ code generated for a source file,
+ * in order to balance the files between compile units.
+ *
+ * Only code that appears in the generated *.cpp file counts, so generic
+ * classes and functions, which are generated into the package header, do
+ * not. Otherwise, each class, function and call counts, as does each use of
+ * a generic type or function with type arguments, which the C++ compiler
+ * must instantiate.
+ *
+ * @ingroup visitor
+ */
+class CostEstimator: public Visitor {
+public:
+  /**
+   * Constructor.
+   */
+  CostEstimator();
+
+  /**
+   * Estimated cost, in arbitrary units.
+   */
+  size_t cost() const;
+
+  using Visitor::visit;
+  virtual void visit(const Class* o);
+  virtual void visit(const Function* o);
+  virtual void visit(const Program* o);
+  virtual void visit(const MemberFunction* o);
+  virtual void visit(const BinaryOperator* o);
+  virtual void visit(const UnaryOperator* o);
+  virtual void visit(const AssignmentOperator* o);
+  virtual void visit(const ConversionOperator* o);
+  virtual void visit(const SliceOperator* o);
+  virtual void visit(const Call* o);
+  virtual void visit(const BinaryCall* o);
+  virtual void visit(const UnaryCall* o);
+  virtual void visit(const NamedExpression* o);
+  virtual void visit(const NamedType* o);
+
+private:
+  /**
+   * Cost of a class, for the boilerplate generated for each (constructors,
+   * member visitors, factory function, etc).
+   */
+  static const size_t CLASS_COST = 20;
+
+  /**
+   * Cost of a function or operator.
+   */
+  static const size_t FUNCTION_COST = 4;
+
+  /**
+   * Cost of a call.
+   */
+  static const size_t CALL_COST = 1;
+
+  /**
+   * Cost of a use of a generic type or function with type arguments.
+   */
+  static const size_t GENERIC_COST = 8;
+
+  /**
+   * Accumulated cost.
+   */
+  size_t total;
+};
+}
@@ -0,0 +1,183 @@
+/**
+ * @file
+ */
+#include "src/visitor/ExactInferrer.hpp"
+
+#include "src/visitor/Gatherer.hpp"
+
+void birch::ExactInferrer::visit(const Package* o) {
+  Gatherer<Class> gatherer;
+  o->accept(&gatherer);
+  for (auto o : gatherer) {
+    classes.insert(std::make_pair(o->name->str(), o));
+  }
+  for (auto file : o->sources) {
+    file->accept(this);
+  }
+}
+
+void birch::ExactInferrer::visit(const Function* o) {
+  infer(o);
+}
+
+void birch::ExactInferrer::visit(const Program* o) {
+  infer(o);
+}
+
+void birch::ExactInferrer::visit(const MemberFunction* o) {
+  infer(o);
+}
+
+void birch::ExactInferrer::visit(const BinaryOperator* o) {
+  infer(o);
+}
+
+void birch::ExactInferrer::visit(const UnaryOperator* o) {
+  infer(o);
+}
+
+void birch::ExactInferrer::visit(const AssignmentOperator* o) {
+  infer(o);
+}
+
+void birch::ExactInferrer::visit(const ConversionOperator* o) {
+  infer(o);
+}
+
+void birch::ExactInferrer::visit(const SliceOperator* o) {
+  infer(o);
+}
+
+void birch::ExactInferrer::visit(const LambdaFunction* o) {
+  infer(o);
+}
+
+void birch::ExactInferrer::visit(const Braces* o) {
+  if (frames.empty()) {
+    Visitor::visit(o);
+  } else {
+    frames.back().scopes.emplace_back();
+    Visitor::visit(o);
+    frames.back().scopes.pop_back();
+  }
+}
+
+void birch::ExactInferrer::visit(const Parameter* o) {
+  Visitor::visit(o);
+  if (!frames.empty()) {
+    /* parameters are never candidates, but may hide those of an enclosing
+     * body */
+    declare(o->name->str(), nullptr, true);
+  }
+}
+
+void birch::ExactInferrer::visit(const LocalVariable* o) {
+  Visitor::visit(o);
+  if (!frames.empty()) {
+    bool excluded = true;
+    auto type = dynamic_cast<const NamedType*>(o->type);
+    if (type && !o->has(LET) && o->brackets->isEmpty() &&
+        o->value->isEmpty()) {
+      auto iter = classes.find(type->name->str());
+      excluded = iter == classes.end() || iter->second->isAlias() ||
+          iter->second->isGeneric() || iter->second->has(ABSTRACT) ||
+          iter->second->has(STRUCT);
+    }
+    declare(o->name->str(), o, excluded);
+  }
+}
+
+void birch::ExactInferrer::visit(const TupleVariable* o) {
+  Visitor::visit(o);
+  if (!frames.empty()) {
+    /* elements are initialized from the tuple, not constructed */
+    for (auto local : *o->locals) {
+      auto named = dynamic_cast<const LocalVariable*>(local);
+      assert(named);
+      find(named->name->str())->excluded = true;
+    }
+  }
+}
+
+void birch::ExactInferrer::visit(const Assign* o) {
+  Visitor::visit(o);
+  assign(o->left);
+}
+
+void birch::ExactInferrer::visit(const Member* o) {
+  Visitor::visit(o);
+  auto left = dynamic_cast<const NamedExpression*>(o->left);
+  auto right = dynamic_cast<const NamedExpression*>(o->right);
+  if (left && right && right->typeArgs->isEmpty()) {
+    auto candidate = find(left->name->str());
+    if (candidate && candidate->local) {
+      candidate->uses.push_back(const_cast<NamedExpression*>(left));
+    }
+  }
+}
+
+void birch::ExactInferrer::visit(const Raw* o) {
+  for (auto& frame : frames) {
+    frame.raw = true;
+  }
+}
+
+template<class T>
+void birch::ExactInferrer::infer(const T* o) {
+  frames.emplace_back();
+  frames.back().scopes.emplace_back();
+  Visitor::visit(o);
+  auto& frame = frames.back();
+  if (!frame.raw) {
+    for (auto& candidate : frame.candidates) {
+      if (!candidate.excluded) {
+        for (auto use : candidate.uses) {
+          use->type = candidate.local->type;
+        }
+      }
+    }
+  }
+  frames.pop_back();
+}
+
+void birch::ExactInferrer::assign(const Expression* o) {
+  if (auto named = dynamic_cast<const NamedExpression*>(o)) {
+    auto candidate = find(named->name->str());
+    if (candidate) {
+      candidate->excluded = true;
+    }
+  } else if (auto parens = dynamic_cast<const Parentheses*>(o)) {
+    assign(parens->strip());
+  } else if (auto list = dynamic_cast<const ExpressionList*>(o)) {
+    assign(list->head);
+    assign(list->tail);
+  }
+}
+
+void birch::ExactInferrer::declare(const std::string& name,
+    const LocalVariable* local, const bool excluded) {
+  auto& frame = frames.back();
+  frame.candidates.push_back(Candidate{local, {}, excluded});
+  auto candidate = &frame.candidates.back();
+  auto result = frame.scopes.back().insert(std::make_pair(name, candidate));
+  if (!result.second) {
+    /* declared more than once in the same scope, uses are ambiguous */
+    result.first->second->excluded = true;
+    candidate->excluded = true;
+    result.first->second = candidate;
+  }
+}
+
+birch::ExactInferrer::Candidate* birch::ExactInferrer::find(
+    const std::string& name) {
+  for (auto frame = frames.rbegin(); frame != frames.rend(); ++frame) {
+    for (auto scope = frame->scopes.rbegin(); scope != frame->scopes.rend();
+        ++scope) {
+      auto iter = scope->find(name);
+      if (iter != scope->end()) {
+        return iter->second;
+      }
+    }
+  }
+  return nullptr;
+}
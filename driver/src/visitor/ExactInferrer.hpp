@@ -0,0 +1,131 @@
+/**
+ * @file
+ */
+#pragma once
+
+#include "src/visitor/Visitor.hpp"
+
+namespace birch {
+/**
+ * Infers which local variables of class type refer, throughout their
+ * lifetime, to an object of exactly their declared type, so that member
+ * function calls on them can be devirtualized.
+ *
+ * A local variable has an exact type if it is declared with a non-generic,
+ * concrete class type and constructor arguments (or none), e.g.
+ * `x:Foo(a, b);`, and is never assigned thereafter, nor is its function
+ * body one containing raw C++ code that could assign it. The type of each
+ * use of such a variable as the left side of a member access, e.g. `x.f(a)`,
+ * is set to the declared type of the variable, so that the generator can
+ * qualify the member (e.g. `x->Foo_::f(a)`) to call it directly rather
+ * than through the virtual function table, which the C++ compiler can then
+ * inline.
+ *
+ * @ingroup visitor
+ */
+class ExactInferrer: public Visitor {
+public:
+  using Visitor::visit;
+  virtual void visit(const Package* o);
+  virtual void visit(const Function* o);
+  virtual void visit(const Program* o);
+  virtual void visit(const MemberFunction* o);
+  virtual void visit(const BinaryOperator* o);
+  virtual void visit(const UnaryOperator* o);
+  virtual void visit(const AssignmentOperator* o);
+  virtual void visit(const ConversionOperator* o);
+  virtual void visit(const SliceOperator* o);
+  virtual void visit(const LambdaFunction* o);
+  virtual void visit(const Braces* o);
+  virtual void visit(const Parameter* o);
+  virtual void visit(const LocalVariable* o);
+  virtual void visit(const TupleVariable* o);
+  virtual void visit(const Assign* o);
+  virtual void visit(const Member* o);
+  virtual void visit(const Raw* o);
+
+private:
+  /**
+   * Local variable or parameter under consideration.
+   */
+  struct Candidate {
+    /**
+     * The local variable, or `nullptr` for a parameter.
+     */
+    const LocalVariable* local;
+
+    /**
+     * Uses as the left side of a member access.
+     */
+    std::list<NamedExpression*> uses;
+
+    /**
+     * Is the type not exact, e.g. because the variable is assigned?
+     */
+    bool excluded;
+  };
+
+  /**
+   * Local variables of a function body under consideration.
+   */
+  struct Frame {
+    /**
+     * All local variables and parameters of the body.
+     */
+    std::list<Candidate> candidates;
+
+    /**
+     * Stack of nested scopes within the body, innermost last, mapping names
+     * to the local variables and parameters currently visible.
+     */
+    std::list<std::unordered_map<std::string,Candidate*>> scopes;
+
+    /**
+     * Does the function body contain raw C++ code?
+     */
+    bool raw = false;
+  };
+
+  /**
+   * Infer for the local variables of a function body.
+   *
+   * @tparam T Function type.
+   *
+   * @param o The function.
+   */
+  template<class T>
+  void infer(const T* o);
+
+  /**
+   * Exclude the local variables assigned by the left side of an assignment.
+   */
+  void assign(const Expression* o);
+
+  /**
+   * Declare a local variable or parameter in the current scope.
+   *
+   * @param name Name.
+   * @param local The local variable, or `nullptr` for a parameter.
+   * @param excluded Can it not have an exact type?
+   */
+  void declare(const std::string& name, const LocalVariable* local,
+      const bool excluded);
+
+  /**
+   * Local variable or parameter of the given name visible in the current
+   * scope, or `nullptr` if none.
+   */
+  Candidate* find(const std::string& name);
+
+  /**
+   * Classes of the package and its dependencies, by name.
+   */
+  std::unordered_map<std::string,const Class*> classes;
+
+  /**
+   * Stack of function bodies, innermost last; lambda functions push a new
+   * frame within that of their enclosing function.
+   */
+  std::list<Frame> frames;
+};
+}
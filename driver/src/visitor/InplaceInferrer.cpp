@@ -0,0 +1,206 @@
+/**
+ * @file
+ */
+#include "src/visitor/InplaceInferrer.hpp"
+
+#include "src/visitor/Gatherer.hpp"
+
+birch::InplaceInferrer::InplaceInferrer(std::ostream* report) :
+    report(report) {
+  //
+}
+
+void birch::InplaceInferrer::visit(const Package* o) {
+  Gatherer<Class> gatherer(
+      [](const Class* o) -> bool {
+        return true;
+      }, false);
+  o->accept(&gatherer);
+  for (auto o : gatherer) {
+    classes.insert(std::make_pair(o->name->str(), o));
+  }
+  for (auto file : o->sources) {
+    file->accept(this);
+  }
+}
+
+void birch::InplaceInferrer::visit(const Function* o) {
+  infer(o);
+}
+
+void birch::InplaceInferrer::visit(const Program* o) {
+  infer(o);
+}
+
+void birch::InplaceInferrer::visit(const MemberFunction* o) {
+  infer(o);
+}
+
+void birch::InplaceInferrer::visit(const BinaryOperator* o) {
+  infer(o);
+}
+
+void birch::InplaceInferrer::visit(const UnaryOperator* o) {
+  infer(o);
+}
+
+void birch::InplaceInferrer::visit(const AssignmentOperator* o) {
+  infer(o);
+}
+
+void birch::InplaceInferrer::visit(const ConversionOperator* o) {
+  infer(o);
+}
+
+void birch::InplaceInferrer::visit(const SliceOperator* o) {
+  infer(o);
+}
+
+void birch::InplaceInferrer::visit(const LambdaFunction* o) {
+  infer(o);
+}
+
+void birch::InplaceInferrer::visit(const LocalVariable* o) {
+  Visitor::visit(o);
+  if (!frames.empty()) {
+    auto& frame = frames.back();
+    auto name = o->name->str();
+    if (!frame.candidates.insert(std::make_pair(name,
+        const_cast<LocalVariable*>(o))).second) {
+      /* declared more than once in the same body, uses are ambiguous */
+      frame.escaped.insert(name);
+    } else if (o->has(LET) || !o->brackets->isEmpty() ||
+        !o->value->isEmpty()) {
+      frame.escaped.insert(name);
+    } else {
+      auto c = resolve(o->type);
+      if (!c || c->has(ABSTRACT) || !isInplace(c)) {
+        frame.escaped.insert(name);
+      }
+    }
+  }
+}
+
+void birch::InplaceInferrer::visit(const TupleVariable* o) {
+  Visitor::visit(o);
+  if (!frames.empty()) {
+    /* elements are initialized from the tuple, not constructed */
+    for (auto local : *o->locals) {
+      auto named = dynamic_cast<const LocalVariable*>(local);
+      assert(named);
+      frames.back().escaped.insert(named->name->str());
+    }
+  }
+}
+
+void birch::InplaceInferrer::visit(const NamedExpression* o) {
+  Visitor::visit(o);
+  escape(o->name->str());
+}
+
+void birch::InplaceInferrer::visit(const Member* o) {
+  /* the right side is the name of a member, not a use of a local variable,
+   * so is not visited */
+  auto named = dynamic_cast<const NamedExpression*>(o->left);
+  if (named && !frames.empty()) {
+    auto& frame = frames.back();
+    if (frame.candidates.find(named->name->str()) == frame.candidates.end()) {
+      /* not local to the innermost body, so may be captured */
+      escape(named->name->str());
+    }
+    named->typeArgs->accept(this);
+  } else {
+    o->left->accept(this);
+  }
+}
+
+void birch::InplaceInferrer::visit(const Raw* o) {
+  /* raw code may use any local variable in scope, including those of
+   * enclosing bodies that a lambda function captures */
+  for (auto& frame : frames) {
+    frame.raw = true;
+  }
+}
+
+template<class T>
+void birch::InplaceInferrer::infer(const T* o) {
+  frames.emplace_back();
+  Visitor::visit(o);
+  auto& frame = frames.back();
+  if (!frame.raw) {
+    for (auto pair : frame.candidates) {
+      if (frame.escaped.find(pair.first) == frame.escaped.end()) {
+        auto local = pair.second;
+        local->set(INPLACE);
+        if (report) {
+          *report << "inplace: " << pair.first << " (" <<
+              local->loc->file->path << ':' << local->loc->firstLine << ')' <<
+              std::endl;
+        }
+      }
+    }
+  }
+  frames.pop_back();
+}
+
+void birch::InplaceInferrer::escape(const std::string& name) {
+  for (auto frame = frames.rbegin(); frame != frames.rend(); ++frame) {
+    if (frame->candidates.find(name) != frame->candidates.end()) {
+      frame->escaped.insert(name);
+      return;
+    }
+  }
+}
+
+const birch::Class* birch::InplaceInferrer::resolve(const Type* o) const {
+  auto named = dynamic_cast<const NamedType*>(o);
+  if (named) {
+    auto iter = classes.find(named->name->str());
+    if (iter != classes.end()) {
+      auto c = iter->second;
+      if (c->isAlias()) {
+        return resolve(c->base);
+      } else if (!c->has(STRUCT)) {
+        return c;
+      }
+    }
+  }
+  return nullptr;
+}
+
+bool birch::InplaceInferrer::isInplace(const Class* o) {
+  auto iter = memo.find(o);
+  if (iter != memo.end()) {
+    return iter->second;
+  }
+  memo.insert(std::make_pair(o, false));  // guard while determining
+
+  /* raw C++ code may do anything with the object */
+  Gatherer<Raw> raws;
+  o->accept(&raws);
+  bool result = raws.size() == 0;
+
+  /* `this` and `super` may only be used for member access, which is the case
+   * if there are as many of those as there are member accesses on them */
+  if (result) {
+    Gatherer<This> thises;
+    Gatherer<Super> supers;
+    Gatherer<Member> members([](const Member* o) -> bool {
+          return o->left->isThis() || o->left->isSuper();
+        });
+    o->accept(&thises);
+    o->accept(&supers);
+    o->accept(&members);
+    result = thises.size() + supers.size() == members.size();
+  }
+
+  /* base class */
+  auto base = dynamic_cast<const NamedType*>(o->base);
+  if (result && base && base->name->str() != "Object") {
+    auto c = resolve(base);
+    result = c && isInplace(c);
+  }
+
+  memo[o] = result;
+  return result;
+}
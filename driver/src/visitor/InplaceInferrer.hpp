@@ -0,0 +1,126 @@
+/**
+ * @file
+ */
+#pragma once
+
+#include "src/visitor/Visitor.hpp"
+
+namespace birch {
+/**
+ * Infers which local variables of class type do not escape the function in
+ * which they are declared, and annotates them to be allocated inplace (on
+ * the stack) rather than on the heap. This avoids an allocation, and the
+ * reference count updates of a shared pointer, for each such variable.
+ *
+ * A local variable is inferred inplace if:
+ *
+ *   - it is declared with a class type and constructor arguments (or none),
+ *     e.g. `x:Foo(a, b);`, rather than initialized with a value,
+ *   - it is only ever used as the left side of a member access, e.g.
+ *     `x.f(a)` or `x.y <- b`, and never assigned, passed as an argument,
+ *     returned or captured by a lambda function, and
+ *   - its function contains no raw C++ code that could use it otherwise.
+ *
+ * Furthermore the class must be of the package, concrete, and neither it nor
+ * any of its base classes may use `this` or `super` other than for member
+ * access, or contain raw C++ code, as either could allow the object itself
+ * to escape through one of its own member functions.
+ *
+ * @ingroup visitor
+ */
+class InplaceInferrer: public Visitor {
+public:
+  /**
+   * Constructor.
+   *
+   * @param report Output stream for a report of the local variables that
+   * were inferred inplace, or `nullptr` for no report.
+   */
+  InplaceInferrer(std::ostream* report = nullptr);
+
+  using Visitor::visit;
+  virtual void visit(const Package* o);
+  virtual void visit(const Function* o);
+  virtual void visit(const Program* o);
+  virtual void visit(const MemberFunction* o);
+  virtual void visit(const BinaryOperator* o);
+  virtual void visit(const UnaryOperator* o);
+  virtual void visit(const AssignmentOperator* o);
+  virtual void visit(const ConversionOperator* o);
+  virtual void visit(const SliceOperator* o);
+  virtual void visit(const LambdaFunction* o);
+  virtual void visit(const LocalVariable* o);
+  virtual void visit(const TupleVariable* o);
+  virtual void visit(const NamedExpression* o);
+  virtual void visit(const Member* o);
+  virtual void visit(const Raw* o);
+
+private:
+  /**
+   * Local variables of a function body under consideration.
+   */
+  struct Frame {
+    /**
+     * Candidate local variables, by name.
+     */
+    std::unordered_map<std::string,LocalVariable*> candidates;
+
+    /**
+     * Names of local variables that escape.
+     */
+    std::unordered_set<std::string> escaped;
+
+    /**
+     * Does the function body contain raw C++ code?
+     */
+    bool raw = false;
+  };
+
+  /**
+   * Infer for the local variables of a function body.
+   *
+   * @tparam T Function type.
+   *
+   * @param o The function.
+   */
+  template<class T>
+  void infer(const T* o);
+
+  /**
+   * Record a use of a name that lets any local variable of that name escape.
+   */
+  void escape(const std::string& name);
+
+  /**
+   * Resolve a type to a class of the package, if possible, following
+   * aliases.
+   */
+  const Class* resolve(const Type* o) const;
+
+  /**
+   * Can objects of a class be allocated inplace?
+   */
+  bool isInplace(const Class* o);
+
+  /**
+   * Output stream for report.
+   */
+  std::ostream* report;
+
+  /**
+   * Classes of the package, by name.
+   */
+  std::unordered_map<std::string,const Class*> classes;
+
+  /**
+   * Memoized results of isInplace().
+   */
+  std::unordered_map<const Class*,bool> memo;
+
+  /**
+   * Stack of function bodies, innermost last; lambda functions push a new
+   * frame within that of their enclosing function.
+   */
+  std::list<Frame> frames;
+};
+}
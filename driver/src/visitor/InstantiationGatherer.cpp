@@ -0,0 +1,78 @@
+/**
+ * @file
+ */
+#include "src/visitor/InstantiationGatherer.hpp"
+
+#include "src/visitor/Gatherer.hpp"
+#include "src/generate/BirchGenerator.hpp"
+
+void birch::InstantiationGatherer::visit(const Package* o) {
+  Gatherer<Class> classes([](const Class* o) {
+        return o->isGeneric() && !o->isAlias();
+      }, false);
+  o->accept(&classes);
+  for (auto o : classes) {
+    generics.insert(std::make_pair(o->name->str(), o));
+  }
+  for (auto file : o->sources) {
+    file->accept(this);
+  }
+}
+
+void birch::InstantiationGatherer::visit(const Class* o) {
+  if (!o->isGeneric()) {
+    Visitor::visit(o);
+  }
+}
+
+void birch::InstantiationGatherer::visit(const Function* o) {
+  if (!o->isGeneric()) {
+    Visitor::visit(o);
+  }
+}
+
+void birch::InstantiationGatherer::visit(const MemberFunction* o) {
+  if (!o->isGeneric()) {
+    Visitor::visit(o);
+  }
+}
+
+void birch::InstantiationGatherer::visit(const BinaryOperator* o) {
+  if (!o->isGeneric()) {
+    Visitor::visit(o);
+  }
+}
+
+void birch::InstantiationGatherer::visit(const UnaryOperator* o) {
+  if (!o->isGeneric()) {
+    Visitor::visit(o);
+  }
+}
+
+void birch::InstantiationGatherer::visit(const NamedType* o) {
+  Visitor::visit(o);
+  auto iter = generics.find(o->name->str());
+  if (iter != generics.end() &&
+      o->typeArgs->width() == iter->second->typeParams->width() &&
+      isClosed(o)) {
+    std::stringstream buf;
+    BirchGenerator output(buf);
+    output << o;
+    if (seen.insert(buf.str()).second) {
+      gathered.push_back(o);
+    }
+  }
+}
+
+bool birch::InstantiationGatherer::isClosed(const Type* o) {
+  auto named = dynamic_cast<const NamedType*>(o);
+  if (!named) {
+    return false;
+  }
+  for (auto arg : *named->typeArgs) {
+    if (!isClosed(arg)) {
+      return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file
+ */
+#pragma once
+
+#include "src/visitor/Visitor.hpp"
+
+namespace birch {
+/**
+ * Gathers the instantiations of the generic classes of a package that are
+ * used by the package itself, so that these may be instantiated explicitly
+ * once, rather than implicitly in every compile unit of the package and of
+ * the packages that depend on it.
+ *
+ * An instantiation is a use of a generic class of the package with type
+ * arguments, e.g. `Random<Real>`, outside of any generic class or function
+ * (within which the arguments may depend on type parameters). Each type
+ * argument must itself be a named type, possibly with type arguments of its
+ * own. Instantiations are gathered once each, in order of first use.
+ *
+ * @ingroup visitor
+ */
+class InstantiationGatherer: public Visitor {
+public:
+  /**
+   * Begin iterator over gathered instantiations.
+   */
+  auto begin() {
+    return gathered.begin();
+  }
+
+  /**
+   * End iterator over gathered instantiations.
+   */
+  auto end() {
+    return gathered.end();
+  }
+
+  /**
+   * Number of instantiations gathered.
+   */
+  auto size() {
+    return gathered.size();
+  }
+
+  using Visitor::visit;
+  virtual void visit(const Package* o);
+  virtual void visit(const Class* o);
+  virtual void visit(const Function* o);
+  virtual void visit(const MemberFunction* o);
+  virtual void visit(const BinaryOperator* o);
+  virtual void visit(const UnaryOperator* o);
+  virtual void visit(const NamedType* o);
+
+private:
+  /**
+   * Is a type argument closed, i.e. a named type whose own type arguments,
+   * if any, are also closed?
+   */
+  static bool isClosed(const Type* o);
+
+  /**
+   * Generic classes of the package, by name.
+   */
+  std::unordered_map<std::string,const Class*> generics;
+
+  /**
+   * Instantiations gathered so far, by their string representation.
+   */
+  std::unordered_set<std::string> seen;
+
+  /**
+   * Gathered instantiations.
+   */
+  std::vector<const NamedType*> gathered;
+};
+}
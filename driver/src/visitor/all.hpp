@@ -5,5 +5,10 @@
  */
 #pragma once
 
+#include "src/visitor/AcyclicInferrer.hpp"
+#include "src/visitor/CostEstimator.hpp"
+#include "src/visitor/ExactInferrer.hpp"
 #include "src/visitor/Gatherer.hpp"
+#include "src/visitor/InplaceInferrer.hpp"
+#include "src/visitor/InstantiationGatherer.hpp"
 #include "src/visitor/Visitor.hpp"
@@ -0,0 +1,89 @@
+/**
+ * @file
+ *
+ * Microbenchmark of the small buffer of libbirch::Array. For vectors of
+ * Real of several lengths, and small buffers of several sizes, reports the
+ * time to copy a vector and write one of its elements, as in `y <- x;
+ * y[1] <- 0.0;`, and to construct a vector from a lambda, as for a
+ * temporary. With a small buffer of zero bytes the elements are always on
+ * the heap, as before the small buffer. Run single threaded, as the
+ * allocator is then cheapest, and optionally with the number of operations
+ * as the first argument.
+ */
+#include "libbirch/libbirch.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+/**
+ * Time a function.
+ *
+ * @param n Number of operations.
+ * @param f Function, taking the number of operations.
+ *
+ * @return Time per operation, in nanoseconds.
+ */
+template<class F>
+double time(const int n, F f) {
+  auto start = std::chrono::steady_clock::now();
+  f(n);
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double,std::nano>(end - start).count()/n;
+}
+
+/**
+ * Time copy-and-write and construction of vectors of a given length with a
+ * small buffer of a given size, and report.
+ *
+ * @tparam B Size of the small buffer, in bytes.
+ *
+ * @param n Number of operations.
+ * @param len Length of the vectors.
+ */
+template<int64_t B>
+void bench(const int n, const int len) {
+  using array_type = libbirch::Array<double,
+      libbirch::DefaultShape<1>::type,B>;
+  auto shape = libbirch::make_shape(len);
+  array_type x([](int64_t i) { return double(i); }, shape);
+  double sum = 0.0;
+
+  double copy = time(n, [&](const int n) {
+    for (int i = 0; i < n; ++i) {
+      array_type y(x);
+      y(1) = double(i);
+      sum += y(len);
+    }
+  });
+  double construct = time(n, [&](const int n) {
+    for (int i = 0; i < n; ++i) {
+      array_type y([=](int64_t j) { return double(i + j); }, shape);
+      sum += y(1);
+    }
+  });
+
+  std::cout << std::setw(8) << B << std::setw(8) << len << std::setw(8) <<
+      sizeof(array_type) << std::fixed << std::setprecision(2) <<
+      std::setw(12) << copy << std::setw(12) << construct;
+  if (sum == 0.0) {
+    std::cout << " ";  // use sum so that the loops are not elided
+  }
+  std::cout << std::endl;
+}
+
+int main(int argc, char** argv) {
+  int n = argc > 1 ? std::stoi(argv[1]) : 1000000;
+
+  std::cout << std::setw(8) << "bytes" << std::setw(8) << "length" <<
+      std::setw(8) << "sizeof" << std::setw(12) << "copy ns" <<
+      std::setw(12) << "new ns" << std::endl;
+  for (int len : {1, 2, 4, 8, 16}) {
+    bench<0>(n, len);
+    bench<32>(n, len);
+    bench<64>(n, len);
+    bench<128>(n, len);
+  }
+  return 0;
+}
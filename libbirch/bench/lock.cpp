@@ -0,0 +1,111 @@
+/**
+ * @file
+ *
+ * Microbenchmark of libbirch::Atomic and libbirch::Lock under contention.
+ * Each thread repeatedly increments a shared counter, or obtains a lock to
+ * increment a shared counter, and the time per operation is reported. A lock
+ * that spins on an exchange without backoff, as Lock once did, is included
+ * for comparison.
+ *
+ * Built as both `lock_bench_openmp` and `lock_bench_std`, with the OpenMP and
+ * std::atomic implementations of Atomic, respectively, see
+ * LIBBIRCH_ATOMIC_OPENMP. Run with e.g. `OMP_NUM_THREADS=64`, and optionally
+ * the number of operations per thread as the first argument.
+ */
+#include "libbirch/libbirch.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+/**
+ * Lock that spins on an exchange, without backoff.
+ */
+class SpinLock {
+public:
+  SpinLock() :
+      lock(false) {
+    //
+  }
+
+  void set() {
+    while (lock.exchangeLock(true));
+  }
+
+  void unset() {
+    lock.storeLock(false);
+  }
+
+private:
+  libbirch::Atomic<bool> lock;
+};
+
+/**
+ * Time a function called on every thread.
+ *
+ * @param name Name to report.
+ * @param n Number of operations per thread.
+ * @param f Function, taking the number of operations.
+ */
+template<class F>
+void time(const std::string& name, const int n, F f) {
+  auto start = std::chrono::steady_clock::now();
+  #pragma omp parallel
+  {
+    f(n);
+  }
+  auto end = std::chrono::steady_clock::now();
+  double ns = std::chrono::duration<double,std::nano>(end - start).count();
+  int nops = n*libbirch::get_max_threads();
+  std::cout << std::left << std::setw(16) << name << std::right <<
+      std::setw(12) << std::fixed << std::setprecision(2) << ns/nops <<
+      " ns/op" << std::endl;
+}
+
+int main(int argc, char** argv) {
+  int n = argc > 1 ? std::stoi(argv[1]) : 1000000;
+
+  std::cout << (LIBBIRCH_ATOMIC_OPENMP ? "OpenMP" : "std::atomic") <<
+      " atomics, " << libbirch::get_max_threads() << " threads" << std::endl;
+
+  libbirch::Atomic<int> counter(0);
+  time("increment", n, [&](const int n) {
+    for (int i = 0; i < n; ++i) {
+      counter.increment();
+    }
+  });
+  time("capture", n, [&](const int n) {
+    for (int i = 0; i < n; ++i) {
+      ++counter;
+    }
+  });
+
+  int value = 0;
+  SpinLock spin;
+  time("spin lock", n, [&](const int n) {
+    for (int i = 0; i < n; ++i) {
+      spin.set();
+      ++value;
+      spin.unset();
+    }
+  });
+
+  libbirch::Lock lock;
+  time("lock", n, [&](const int n) {
+    for (int i = 0; i < n; ++i) {
+      lock.set();
+      ++value;
+      lock.unset();
+    }
+  });
+
+  /* check mutual exclusion */
+  int expected = 2*n*libbirch::get_max_threads();
+  if (value != expected) {
+    std::cerr << "error: expected " << expected << ", got " << value <<
+        std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file
+ *
+ * Microbenchmark of the last reference optimization of libbirch::Shared.
+ * Reports the time for the first use of a lazy copy, as in `y <- copy(x);
+ * y.f();`, both where the original remains referenced, so that the object
+ * must be copied, and where it does not, so that the copy is elided. Each is
+ * run on the thread that owns the object, and on one that does not. Run with
+ * at least two threads, and optionally with the number of operations as the
+ * first argument.
+ */
+#include "libbirch/libbirch.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+using namespace libbirch;
+
+class Node : public Any {
+public:
+  LIBBIRCH_CLASS(Node, Any)
+  LIBBIRCH_CLASS_MEMBERS(value)
+
+  Node() = default;
+
+  Node(Deserializer& visitor_) :
+      Any(visitor_),
+      value(visitor_.read<int>()) {
+    //
+  }
+
+  int value = 0;
+};
+
+/**
+ * Time the first use of lazy copies, and report.
+ *
+ * @param n Number of operations.
+ * @param unique Is the original released before the first use?
+ * @param tid Thread on which to use the copies; thread 0 owns the objects.
+ */
+void bench(const int n, const bool unique, const int tid) {
+  std::vector<Shared<Node>> xs(n), ys;
+  for (auto& x : xs) {
+    x.bridge();
+    ys.push_back(x.copy());
+  }
+  if (unique) {
+    xs.clear();
+  }
+
+  double t = 0.0;
+  int sum = 0;
+  #pragma omp parallel
+  {
+    if (get_thread_num() == tid) {
+      auto start = std::chrono::steady_clock::now();
+      for (auto& y : ys) {
+        sum += y.get()->value;
+      }
+      auto end = std::chrono::steady_clock::now();
+      t = std::chrono::duration<double,std::nano>(end - start).count()/n;
+    }
+  }
+
+  std::cout << std::setw(8) << (unique ? "unique" : "shared") <<
+      std::setw(8) << (tid == 0 ? "owner" : "other") << std::fixed <<
+      std::setprecision(2) << std::setw(12) << t << std::endl;
+  if (sum != 0) {
+    std::cout << " ";  // use sum so that the loop is not elided
+  }
+  xs.clear();
+  ys.clear();
+  collect();
+}
+
+int main(int argc, char** argv) {
+  int n = argc > 1 ? std::stoi(argv[1]) : 1000000;
+  if (get_max_threads() < 2) {
+    std::cerr << "run with at least two threads" << std::endl;
+    return 1;
+  }
+
+  std::cout << std::setw(8) << "count" << std::setw(8) << "thread" <<
+      std::setw(12) << "get ns" << std::endl;
+  for (bool unique : {false, true}) {
+    for (int tid : {0, 1}) {
+      bench(n, unique, tid);
+    }
+  }
+  return 0;
+}
@@ -3,9 +3,12 @@
  */
 #include "libbirch/Any.hpp"
 #include "libbirch/Destroyer.hpp"
+#include "libbirch/Deserializer.hpp"
 
 libbirch::Any::Any() :
-    r_(0),
+    r_(1),
+    b_(0),
+    o_(get_owner_id()),
     a_(0),
     l_(std::numeric_limits<int>::max()),
     h_(0),
@@ -18,15 +21,29 @@ libbirch::Any::Any(const Any& o) : Any() {
   //  
 }
 
+libbirch::Any::Any(Deserializer& visitor) : Any() {
+  visitor.objects.push_back(this);
+  visitor.complete.push_back(false);
+
+  /* restore the results of bridge finding, see Serializer */
+  a_ = visitor.read<int>();
+  k_ = visitor.read<int>();
+  n_ = visitor.read<int>();
+}
+
 void libbirch::Any::destroy_() {
   Destroyer v;
   this->accept_(v);
 }
 
 void libbirch::Any::decShared_() {
-  assert(numShared_() > 0);
+  assert(tryNumShared_() != 0);
 
-  auto r = --r_;
+  auto r = dec_();
+  if (r < 0) {
+    /* biased toward another thread, already registered by dec_() */
+    return;
+  }
   auto old = f_.exchangeOr(BUFFERED|POSSIBLE_ROOT);
   if (r == 0) {
     destroy_();
@@ -46,9 +63,9 @@ void libbirch::Any::decShared_() {
 }
 
 void libbirch::Any::decSharedBiconnected_() {
-  assert(numShared_() > 0);
+  assert(tryNumShared_() != 0);
 
-  auto r = --r_;
+  auto r = dec_();
   if (r == 0) {
     destroy_();
 
@@ -66,10 +83,18 @@ void libbirch::Any::decSharedBiconnected_() {
 }
 
 void libbirch::Any::decSharedBridge_() {
-  assert(numShared_() > 0);
+  assert(tryNumShared_() != 0);
 
-  auto r = --r_;
-  if (r == a_ - 1) {
+  /* the test against a_ below must be exact, so end any bias toward this
+   * thread first */
+  if (isBiased_()) {
+    merge_();
+  }
+  auto r = dec_();
+  if (r < 0) {
+    /* biased toward another thread, already registered by dec_() */
+    return;
+  } else if (r == a_ - 1) {
     /* last external reference just removed, remainder are internal to the
      * biconnected component; collect the whole biconnected component now */
 
@@ -80,9 +105,9 @@ void libbirch::Any::decSharedBridge_() {
      * edge that decrements the head node reference count to zero will destroy
      * it before the visit has finished; to avoid, we restore the count first,
      * then visit, then decrement again */
-    r_.increment();
+    r_.add(2);
     biconnected_collect(this);
-    r_.decrement();
+    r_.subtract(2);
     assert(r_.load() == 0);
     destroy_();
 
@@ -103,15 +128,24 @@ void libbirch::Any::decSharedBridge_() {
 }
 
 void libbirch::Any::decSharedAcyclic_() {
-  assert(numShared_() > 0);
+  assert(tryNumShared_() != 0);
   assert(isAcyclic_());
 
-  auto r = --r_;
+  auto r = dec_();
   if (r == 0) {
     destroy_();
 
     /* acyclic objects are so for life, and are never registered as possible
-     * roots; can deallocate immediately */
-    deallocate_();
+     * roots, but may be registered to merge a biased count, see dec_() */
+    if (!(f_.load() & BUFFERED)) {
+      deallocate_();
+    }
+  }
+}
+
+void libbirch::Any::defer_() {
+  auto old = f_.exchangeOr(isAcyclic_() ? BUFFERED : BUFFERED|POSSIBLE_ROOT);
+  if (!(old & BUFFERED)) {
+    register_possible_root(this);
   }
 }
@@ -52,6 +52,23 @@ enum Flag : int8_t {
  * 
  * Members of Any use an underscore suffix (e.g. `n_` instead of `n`) in order
  * to avoid naming collisions with derived classes.
+ *
+ * Reference counts are biased toward the thread that creates the object, its
+ * owner: the owner counts references with plain loads and stores, while other
+ * threads use atomic operations on a separate count. The two counts are
+ * merged when the owner's count reaches zero. Where a thread other than the
+ * owner cannot determine whether the object has any remaining references,
+ * the object is registered as a possible root, and the counts merged during
+ * collect(). It registers the object *before* decrementing, so that the
+ * owner, should it then merge the counts to zero, finds the object
+ * registered and leaves its deallocation to collect(). An object whose last
+ * reference is released by a thread other than its owner is therefore
+ * retained until the next collect().
+ *
+ * While the count is biased toward another thread, this thread cannot read
+ * it exactly, as the owner updates the biased count concurrently. The last
+ * reference optimization of Shared::get() (see isUniqueHead_()) is then
+ * skipped, and the object copied.
  */
 class Any {
   friend class Marker;
@@ -66,6 +83,7 @@ class Any {
   friend class BiconnectedCopier;
   friend class BiconnectedMemo;
   friend class Destroyer;
+  friend class Serializer;
 public:
   using this_type_ = Any;
 
@@ -79,6 +97,11 @@ public:
    */
   Any(const Any& o);
 
+  /**
+   * Deserialization constructor.
+   */
+  Any(Deserializer& visitor);
+
   /**
    * Destructor.
    */
@@ -100,7 +123,9 @@ public:
   void deallocate_();
 
   /**
-   * Reference count.
+   * Reference count. This is exact only where the count is not updated
+   * concurrently, e.g. during collect(); otherwise see isUnique_() and
+   * isUniqueHead_().
    */
   int numShared_() const;
 
@@ -137,13 +162,15 @@ public:
   void decSharedAcyclic_();
 
   /**
-   * Is there only one reference to this object?
+   * Is there only one reference to this object? False if this cannot be
+   * determined by this thread, as the count is biased toward another thread.
    */
   bool isUnique_() const;
 
   /**
    * Is there only one external reference to this object, assuming that it is
-   * the head node of a biconnected component?
+   * the head node of a biconnected component? False if this cannot be
+   * determined by this thread, as the count is biased toward another thread.
    */
   bool isUniqueHead_() const;
 
@@ -162,11 +189,26 @@ public:
    */
   void unbuffer_();
 
+  /**
+   * If the reference count is biased, merge the biased count into the shared
+   * count, ending the bias. Must only be called by the owner thread, or by
+   * collect().
+   *
+   * @return The reference count if it was biased, otherwise -1.
+   */
+  int unbias_();
+
   /**
    * Get the class name.
    */
   virtual const char* getClassName_() const;
 
+  /**
+   * Get the key of the class for deserialization, see register_class(). This
+   * is null for a class that is not registered.
+   */
+  virtual const char* getClassKey_() const;
+
   /**
    * Shallow copy the object.
    */
@@ -214,12 +256,63 @@ public:
     //
   }
 
+  virtual void accept_(Serializer& visitor) {
+    //
+  }
+
 private:
   /**
-   * Reference count.
+   * Is the reference count biased toward the current thread?
+   */
+  bool isBiased_() const;
+
+  /**
+   * Merge the biased reference count into the shared reference count.
+   *
+   * @return The reference count.
+   */
+  int merge_();
+
+  /**
+   * Reference count, if it can be determined by this thread, otherwise -1.
+   * It cannot while the count is biased toward another thread, as the two
+   * counts are then updated concurrently, and cannot be read together.
+   */
+  int tryNumShared_() const;
+
+  /**
+   * Decrement the reference count. If the count is biased toward another
+   * thread, first registers as a possible root, see defer_().
+   *
+   * @return The new reference count, or -1 if it cannot be determined by
+   * this thread, as the count is biased toward another thread. In that case
+   * the object may have been deallocated by another thread already, and
+   * must not be accessed.
+   */
+  int dec_();
+
+  /**
+   * Register as a possible root, so that the reference count is merged during
+   * collect(), when it cannot otherwise be determined.
+   */
+  void defer_();
+
+  /**
+   * Shared reference count, in units of two. The lowest bit is set while the
+   * count is biased toward the owner thread.
    */
   Atomic<int> r_;
 
+  /**
+   * Biased reference count, updated by the owner thread only.
+   */
+  Atomic<int> b_;
+
+  /**
+   * Id of the owner thread, see get_owner_id().
+   */
+  int o_;
+
   /**
    * Account of references, used for bridge finding. For the head of a
    * biconnected component (i.e. HEAD flag is set), this is the number of
@@ -264,7 +357,7 @@ private:
 }
 
 inline libbirch::Any::~Any() {
-  assert(r_.load() == 0);
+  assert(numShared_() == 0);
 }
 
 inline libbirch::Any& libbirch::Any::operator=(const Any&) {
@@ -276,24 +369,35 @@ inline void libbirch::Any::deallocate_() {
 }
 
 inline int libbirch::Any::numShared_() const {
-  return r_.load();
+  return b_.load() + (r_.load() & ~1)/2;
 }
 
 inline void libbirch::Any::incShared_() {
-  r_.increment();
+  if (isBiased_()) {
+    b_.store(b_.load() + 1);
+  } else {
+    r_.add(2);
+  }
 }
 
 inline void libbirch::Any::decSharedReachable_() {
-  assert(numShared_() > 0);
-  r_.decrement();
+  assert(tryNumShared_() != 0);
+
+  /* the object remains reachable, so there is no need to register it as
+   * dec_() would */
+  if (isBiased_()) {
+    dec_();
+  } else {
+    r_ -= 2;
+  }
 }
 
 inline bool libbirch::Any::isUnique_() const {
-  return numShared_() == 1;
+  return tryNumShared_() == 1;
 }
 
 inline bool libbirch::Any::isUniqueHead_() const {
-  return numShared_() == a_;
+  return tryNumShared_() == a_;
 }
 
 inline bool libbirch::Any::isAcyclic_() const {
@@ -308,6 +412,60 @@ inline void libbirch::Any::unbuffer_() {
   f_.maskAnd(~(BUFFERED|POSSIBLE_ROOT));
 }
 
+inline int libbirch::Any::unbias_() {
+  return (r_.load() & 1) ? merge_() : -1;
+}
+
 inline const char* libbirch::Any::getClassName_() const {
   return "Any";
 }
+
+inline const char* libbirch::Any::getClassKey_() const {
+  return nullptr;
+}
+
+inline bool libbirch::Any::isBiased_() const {
+  return (r_.load() & 1) && o_ == get_owner_id();
+}
+
+inline int libbirch::Any::merge_() {
+  int b = b_.load();
+  b_.store(0);
+  return (r_ += 2*b - 1)/2;
+}
+
+inline int libbirch::Any::tryNumShared_() const {
+  int r = r_.load();
+  if (!(r & 1)) {
+    return r/2;
+  } else if (o_ == get_owner_id()) {
+    return b_.load() + (r & ~1)/2;
+  } else {
+    return -1;
+  }
+}
+
+inline int libbirch::Any::dec_() {
+  if (isBiased_()) {
+    int b = b_.load() - 1;
+    b_.store(b);
+    int r = r_.load();
+    if (b > 0 && r > 0) {
+      /* other threads hold at least as many references as they counted, so
+       * this thread still holds some; the bias can remain */
+      return b + r/2;
+    } else {
+      return merge_();
+    }
+  } else {
+    if (r_.load() & 1) {
+      /* biased toward another thread; register before decrementing, as
+       * after, the owner may merge the count to zero and, finding the
+       * object unregistered, deallocate it; once the bias ends it cannot
+       * resume, so if not biased now the count will be exact */
+      defer_();
+    }
+    int r = (r_ -= 2);
+    return (r & 1) ? -1 : r/2;
+  }
+}
@@ -0,0 +1,81 @@
+/**
+ * @file
+ */
+#pragma once
+
+#include "libbirch/external.hpp"
+
+/**
+ * @def LIBBIRCH_NO_UNIQUE_ADDRESS
+ *
+ * Attribute for a member that may share its address with other members, so
+ * that an empty member, such as ArrayStorage with no inline storage, takes
+ * no space. Supported as an extension before C++20 by some compilers.
+ */
+#if defined(__has_cpp_attribute) && __has_cpp_attribute(no_unique_address)
+#define LIBBIRCH_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#else
+#define LIBBIRCH_NO_UNIQUE_ADDRESS
+#endif
+
+namespace libbirch {
+/**
+ * Inline storage for the elements of an Array, used when the shape of the
+ * array is fixed or its volume is small, so that no allocation is
+ * required.
+ *
+ * @ingroup libbirch
+ *
+ * @tparam T Value type.
+ * @tparam n Number of elements, zero for no inline storage.
+ *
+ * The storage is left uninitialized; the array constructs and destroys
+ * elements within it.
+ */
+template<class T, int64_t n>
+class ArrayStorage {
+public:
+  /**
+   * Pointer to the storage.
+   */
+  T* data() {
+    return reinterpret_cast<T*>(bytes);
+  }
+
+  /**
+   * Pointer to the storage.
+   */
+  const T* data() const {
+    return reinterpret_cast<const T*>(bytes);
+  }
+
+private:
+  /**
+   * Storage.
+   */
+  alignas(T) char bytes[n*sizeof(T)];
+};
+
+/**
+ * No inline storage.
+ *
+ * @ingroup libbirch
+ */
+template<class T>
+class ArrayStorage<T,0> {
+public:
+  /**
+   * Pointer to the storage, always null.
+   */
+  T* data() {
+    return nullptr;
+  }
+
+  /**
+   * Pointer to the storage, always null.
+   */
+  const T* data() const {
+    return nullptr;
+  }
+};
+}
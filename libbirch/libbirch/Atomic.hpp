@@ -13,8 +13,15 @@
  * multithreading, is disabled (this can improve performance significantly for
  * single threading). The disadvantage is that OpenMP atomics do not support
  * compare-and-swap/compare-and-exchange, only swap/exchange, which can
- * require some clunkier client code, especially for read-write locks.
+ * require some clunkier client code, especially for read-write locks. The
+ * std::atomic implementation uses acquire and release memory orders for lock
+ * operations, where OpenMP uses sequential consistency.
+ *
+ * May be defined before inclusion, e.g. with `-DLIBBIRCH_ATOMIC_OPENMP=0`, to
+ * select the implementation; it must be the same for libbirch and all
+ * packages linked with it.
  */
+#ifndef LIBBIRCH_ATOMIC_OPENMP
 #ifdef __APPLE__
 /* on Mac, OpenMP atomics appear to cause crashes when release mode is
  * enabled */
@@ -22,6 +29,7 @@
 #else
 #define LIBBIRCH_ATOMIC_OPENMP 1
 #endif
+#endif
 
 #if !LIBBIRCH_ATOMIC_OPENMP
 #include <atomic>
@@ -79,15 +87,15 @@ public:
   }
 
   /**
-   * Store the value, atomically, with memory order appropriate for use with a
-   * lock.
+   * Store the value, atomically, with memory order appropriate for releasing
+   * a lock.
    */
   void storeLock(const T& value) {
     #if LIBBIRCH_ATOMIC_OPENMP
     #pragma omp atomic write seq_cst
     this->value = value;
     #else
-    this->value.store(value, std::memory_order_seq_cst);
+    this->value.store(value, std::memory_order_release);
     #endif
   }
 
@@ -113,8 +121,8 @@ public:
   }
 
   /**
-   * Exchange the value with another, with memory order appropriate for use
-   * with a lock.
+   * Exchange the value with another, with memory order appropriate for
+   * obtaining a lock.
    *
    * @param value New value.
    *
@@ -130,7 +138,7 @@ public:
     }
     return old;
     #else
-    return this->value.exchange(value, std::memory_order_seq_cst);
+    return this->value.exchange(value, std::memory_order_acquire);
     #endif
   }
 
@@ -51,8 +51,8 @@ public:
     }
   }
 
-  template<class T, class F>
-  void visit(Array<T,F>& o);
+  template<class T, class F, int64_t B>
+  void visit(Array<T,F,B>& o);
 
   template<class T>
   void visit(Inplace<T>& o);
@@ -75,8 +75,8 @@ private:
 #include "libbirch/Shared.hpp"
 #include "libbirch/Any.hpp"
 
-template<class T, class F>
-void libbirch::BiconnectedCopier::visit(Array<T,F>& o) {
+template<class T, class F, int64_t B>
+void libbirch::BiconnectedCopier::visit(Array<T,F,B>& o) {
   if (!std::is_trivially_copyable<T>::value) {
     auto iter = o.begin();
     auto last = o.end();
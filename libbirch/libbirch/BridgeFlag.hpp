@@ -0,0 +1,58 @@
+/**
+ * @file
+ */
+#pragma once
+
+#include "libbirch/external.hpp"
+#include "libbirch/internal.hpp"
+
+namespace libbirch {
+/**
+ * @internal
+ *
+ * Reference to the bridge flag of a Shared<T>, for any `T`. The flag is a
+ * bit field, so cannot be referenced directly.
+ *
+ * @ingroup libbirch
+ */
+class BridgeFlag {
+public:
+  /**
+   * Constructor.
+   *
+   * @param o The edge.
+   */
+  template<class T>
+  BridgeFlag(Shared<T>& o) :
+      o(&o),
+      f(&assign<T>) {
+    //
+  }
+
+  /**
+   * Set the flag.
+   */
+  void set(const bool b) {
+    f(o, b);
+  }
+
+private:
+  /**
+   * Set the flag of an edge of type Shared<T>.
+   */
+  template<class T>
+  static void assign(void* o, const bool b) {
+    static_cast<Shared<T>*>(o)->b = b;
+  }
+
+  /**
+   * The edge.
+   */
+  void* o;
+
+  /**
+   * Function to set the flag of the edge.
+   */
+  void (*f)(void*, const bool);
+};
+}
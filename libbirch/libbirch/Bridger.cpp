@@ -11,6 +11,7 @@ std::tuple<int,int,int,int> libbirch::Bridger::visit(const int j, const int k,
     if (o->a_ < o->numShared_()) {
       l = 0;
       h = MAX;
+      external = true;
     } else {
       l = o->l_;
       h = o->h_;
@@ -24,7 +25,7 @@ std::tuple<int,int,int,int> libbirch::Bridger::visit(const int j, const int k,
     //o->a_ = 0;  // keep this, used later in BiconnectedCollector
     o->k_ = k;
     o->n_ = n;
-    o->f_.maskAnd(~(CLAIMED|POSSIBLE_ROOT));
+    o->f_.maskAnd(release ? ~(CLAIMED|POSSIBLE_ROOT) : ~POSSIBLE_ROOT);
     // ^ while we're here, object is definitely reachable, so not a root
     return std::make_tuple(l, h, m, n);
   } else {
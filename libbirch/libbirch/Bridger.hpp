@@ -5,6 +5,7 @@
 
 #include "libbirch/external.hpp"
 #include "libbirch/internal.hpp"
+#include "libbirch/BridgeFlag.hpp"
 
 namespace libbirch {
 /**
@@ -18,6 +19,52 @@ class Bridger {
 public:
   static constexpr int MAX = std::numeric_limits<int>::max();
 
+  /**
+   * Constructor.
+   *
+   * @param release Release claims made by Spanner? Not when the Spanner is
+   * deferring objects, see Spanner::isDeferring().
+   */
+  Bridger(const bool release = true) :
+      release(release),
+      external(false) {
+    //
+  }
+
+  /**
+   * Did this visitor find an object with more references than the edges
+   * followed to it, i.e. with references from outside the search?
+   */
+  bool hasExternal() const {
+    return external;
+  }
+
+  /**
+   * Add an edge found to be a bridge elsewhere, so that it is included in
+   * reset().
+   */
+  void add(const BridgeFlag& b) {
+    bridges.push_back(b);
+  }
+
+  /**
+   * Add the edges found to be bridges by another visitor.
+   */
+  void splice(Bridger& o) {
+    bridges.insert(bridges.end(), o.bridges.begin(), o.bridges.end());
+    o.bridges.clear();
+  }
+
+  /**
+   * Unset the bridge flags of all edges found to be bridges.
+   */
+  void reset() {
+    for (auto& b : bridges) {
+      b.set(false);
+    }
+    bridges.clear();
+  }
+
   std::tuple<int,int,int,int> visit(const int j, const int k) {
     return std::make_tuple(MAX, 0, 0, 0);
   }
@@ -53,8 +100,8 @@ public:
     }
   }
 
-  template<class T, class F>
-  std::tuple<int,int,int,int> visit(const int j, const int k, Array<T,F>& o);
+  template<class T, class F, int64_t B>
+  std::tuple<int,int,int,int> visit(const int j, const int k, Array<T,F,B>& o);
 
   template<class T>
   std::tuple<int,int,int,int> visit(const int j, const int k, Inplace<T>& o);
@@ -63,6 +110,22 @@ public:
   std::tuple<int,int,int,int> visit(const int j, const int k, Shared<T>& o);
 
   std::tuple<int,int,int,int> visit(const int j, const int k, Any* o);
+
+private:
+  /**
+   * Bridge flags of edges found to be bridges, see reset().
+   */
+  std::vector<BridgeFlag> bridges;
+
+  /**
+   * Release claims made by Spanner?
+   */
+  bool release;
+
+  /**
+   * Was an object found with references from outside the search?
+   */
+  bool external;
 };
 }
 
@@ -71,8 +134,8 @@ public:
 #include "libbirch/Shared.hpp"
 #include "libbirch/Any.hpp"
 
-template<class T, class F>
-std::tuple<int,int,int,int> libbirch::Bridger::visit(const int j, const int k, Array<T,F>& o) {
+template<class T, class F, int64_t B>
+std::tuple<int,int,int,int> libbirch::Bridger::visit(const int j, const int k, Array<T,F,B>& o) {
   int l = MAX, h = 0, m = 0, n = 0, l1, h1, m1, n1;
   if (!std::is_trivially_copyable<T>::value) {
     auto iter = o.begin();
@@ -104,6 +167,7 @@ std::tuple<int,int,int,int> libbirch::Bridger::visit(const int j, const int k,
     if (l == j && h < j + m) {
       /* is a bridge */
       o.b = true;
+      bridges.push_back(BridgeFlag(o));
       n = 0;  // base case for post-order rank in biconnected component
     }
     return std::make_tuple(l, h, m, n);
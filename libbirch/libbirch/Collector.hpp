@@ -46,8 +46,8 @@ public:
     }
   }
 
-  template<class T, class F>
-  void visit(Array<T,F>& o);
+  template<class T, class F, int64_t B>
+  void visit(Array<T,F,B>& o);
 
   template<class T>
   void visit(Inplace<T>& o);
@@ -65,8 +65,8 @@ public:
 #include "libbirch/Any.hpp"
 #include "libbirch/BiconnectedCollector.hpp"
 
-template<class T, class F>
-void libbirch::Collector::visit(Array<T,F>& o) {
+template<class T, class F, int64_t B>
+void libbirch::Collector::visit(Array<T,F,B>& o) {
   if (!std::is_trivially_copyable<T>::value) {
     auto iter = o.begin();
     auto last = o.end();
@@ -44,8 +44,8 @@ public:
     }
   }
 
-  template<class T, class F>
-  void visit(Array<T,F>& o);
+  template<class T, class F, int64_t B>
+  void visit(Array<T,F,B>& o);
 
   template<class T>
   void visit(Inplace<T>& o);
@@ -68,8 +68,8 @@ private:
 #include "libbirch/Shared.hpp"
 #include "libbirch/Any.hpp"
 
-template<class T, class F>
-void libbirch::Copier::visit(Array<T,F>& o) {
+template<class T, class F, int64_t B>
+void libbirch::Copier::visit(Array<T,F,B>& o) {
   if (!std::is_trivially_copyable<T>::value) {
     auto iter = o.begin();
     auto last = o.end();
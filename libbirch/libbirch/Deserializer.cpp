@@ -0,0 +1,76 @@
+/**
+ * @file
+ */
+#include "libbirch/Deserializer.hpp"
+
+#include <iostream>
+#include <cstring>
+
+/**
+ * Registered classes, by key.
+ */
+static std::unordered_map<std::string,libbirch::Any*(*)(libbirch::Deserializer&)>&
+    factories() {
+  /* function-local, so that it is constructed before first use during static
+   * initialization */
+  static std::unordered_map<std::string,libbirch::Any*(*)(libbirch::Deserializer&)> f;
+  return f;
+}
+
+const char* libbirch::register_class(const char* key,
+    Any* (*f)(Deserializer&)) {
+  factories()[key] = f;
+  return key;
+}
+
+libbirch::Deserializer::Deserializer(const char* bytes, const size_t n) :
+    from(bytes),
+    to(bytes + n) {
+  //
+}
+
+std::string libbirch::Deserializer::read(std::in_place_type_t<std::string>) {
+  auto n = read<int64_t>();
+  if (n < 0 || n > to - from) {
+    error("serialized bytes are truncated or corrupt");
+  }
+  std::string o(from, n);
+  from += n;
+  return o;
+}
+
+void libbirch::Deserializer::read(void* ptr, const size_t n) {
+  if (size_t(to - from) < n) {
+    error("serialized bytes are truncated or corrupt");
+  }
+  std::memcpy(ptr, from, n);
+  from += n;
+}
+
+std::pair<libbirch::Any*,bool> libbirch::Deserializer::readObject() {
+  auto i = read<int64_t>();
+  if (0 <= i && i < int64_t(objects.size())) {
+    return std::make_pair(objects[i], bool(complete[i]));
+  } else if (i == int64_t(objects.size())) {
+    auto key = read<std::string>();
+    auto iter = factories().find(key);
+    if (iter == factories().end()) {
+      error(("unknown class " + key + "; serialized bytes can only be " +
+          "read by the same program").c_str());
+    }
+
+    /* the constructor of Any appends the object to objects, before its
+     * members are read, so that references back to it can be resolved */
+    auto o = iter->second(*this);
+    assert(objects[i] == o);
+    complete[i] = true;
+    return std::make_pair(o, true);
+  } else {
+    error("serialized bytes are truncated or corrupt");
+  }
+}
+
+void libbirch::Deserializer::error(const char* msg) {
+  std::cerr << "error: " << msg << std::endl;
+  std::exit(EXIT_FAILURE);
+}
@@ -0,0 +1,198 @@
+/**
+ * @file
+ */
+#pragma once
+
+#include "libbirch/external.hpp"
+#include "libbirch/internal.hpp"
+
+namespace libbirch {
+/**
+ * @internal
+ *
+ * Deserialize a graph from bytes written by Serializer. Rather than visiting
+ * existing objects, values are read to construct new objects: each class has
+ * a constructor that takes a Deserializer and reads each of its member
+ * variables in turn, and is registered by LIBBIRCH_CLASS so that it can be
+ * constructed given the key of its class, see register_class().
+ *
+ * @ingroup libbirch
+ */
+class Deserializer {
+  friend class Any;
+public:
+  /**
+   * Constructor.
+   *
+   * @param bytes Serialized bytes.
+   * @param n Number of bytes.
+   */
+  Deserializer(const char* bytes, const size_t n);
+
+  /**
+   * Read a value.
+   *
+   * @tparam T Value type.
+   */
+  template<class T>
+  T read() {
+    return read(std::in_place_type<T>);
+  }
+
+  /**
+   * Have all bytes been read?
+   */
+  bool empty() const {
+    return from == to;
+  }
+
+private:
+  template<class T>
+  T read(std::in_place_type_t<T>) {
+    if constexpr (std::is_trivially_copyable<T>::value) {
+      T o;
+      read(&o, sizeof(T));
+      return o;
+    } else {
+      error("cannot deserialize a value of this type");
+    }
+  }
+
+  template<class... Args>
+  std::tuple<Args...> read(std::in_place_type_t<std::tuple<Args...>>) {
+    /* braced initialization ensures left-to-right evaluation */
+    return std::tuple<Args...>{read<Args>()...};
+  }
+
+  template<class T>
+  std::optional<T> read(std::in_place_type_t<std::optional<T>>) {
+    if (read<bool>()) {
+      return std::optional<T>(read<T>());
+    } else {
+      return std::nullopt;
+    }
+  }
+
+  std::string read(std::in_place_type_t<std::string>);
+
+  template<class T, class F, int64_t B>
+  Array<T,F,B> read(std::in_place_type_t<Array<T,F,B>>);
+
+  template<class T>
+  Inplace<T> read(std::in_place_type_t<Inplace<T>>);
+
+  template<class T>
+  Shared<T> read(std::in_place_type_t<Shared<T>>);
+
+  /**
+   * Read bytes.
+   */
+  void read(void* ptr, const size_t n);
+
+  /**
+   * Read an object, constructing it if not already constructed.
+   *
+   * @return The object, and whether its construction has completed.
+   */
+  std::pair<Any*,bool> readObject();
+
+  /**
+   * Report an error, and exit.
+   */
+  [[noreturn]] static void error(const char* msg);
+
+  /**
+   * Next byte to read.
+   */
+  const char* from;
+
+  /**
+   * One past the last byte to read.
+   */
+  const char* to;
+
+  /**
+   * Objects constructed so far, in the order written.
+   */
+  std::vector<Any*> objects;
+
+  /**
+   * For each object, has its construction completed?
+   */
+  std::vector<bool> complete;
+};
+
+/**
+ * @internal
+ *
+ * Register a class for deserialization.
+ *
+ * @ingroup libbirch
+ *
+ * @param key Key of the class.
+ * @param f Function to construct an object of the class with a
+ * Deserializer.
+ *
+ * @return @p key.
+ */
+const char* register_class(const char* key, Any* (*f)(Deserializer&));
+
+/**
+ * @internal
+ *
+ * Register a class for deserialization, see LIBBIRCH_VIRTUAL.
+ *
+ * @ingroup libbirch
+ *
+ * @tparam T Class type.
+ *
+ * @return Key of the class.
+ */
+template<class T>
+const char* register_class() {
+  return register_class(typeid(T).name(), [](Deserializer& visitor) -> Any* {
+    return new T(visitor);
+  });
+}
+}
+
+#include "libbirch/Array.hpp"
+#include "libbirch/Inplace.hpp"
+#include "libbirch/Shared.hpp"
+#include "libbirch/Any.hpp"
+
+template<class T, class F, int64_t B>
+libbirch::Array<T,F,B> libbirch::Deserializer::read(
+    std::in_place_type_t<Array<T,F,B>>) {
+  F shape;
+  if constexpr (!Array<T,F,B>::isFixed) {
+    static_assert(1 <= F::count() && F::count() <= 2,
+        "only vectors and matrices can be deserialized");
+    auto rows = read<int64_t>();
+    auto cols = read<int64_t>();
+    shape = F(rows, cols);
+  }
+  return Array<T,F,B>([&](const int64_t) { return read<T>(); }, shape);
+}
+
+template<class T>
+libbirch::Inplace<T> libbirch::Deserializer::read(
+    std::in_place_type_t<Inplace<T>>) {
+  return Inplace<T>(std::in_place, *this);
+}
+
+template<class T>
+libbirch::Shared<T> libbirch::Deserializer::read(
+    std::in_place_type_t<Shared<T>>) {
+  auto b = read<bool>();
+  Any* o;
+  bool done;
+  std::tie(o, done) = readObject();
+  Shared<T> result(static_cast<T*>(o), b);
+  if (!done) {
+    /* a reference back to an object still under construction, which is
+     * therefore on a cycle */
+    result.a = false;
+  }
+  return result;
+}
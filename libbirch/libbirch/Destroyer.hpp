@@ -43,8 +43,8 @@ public:
     }
   }
 
-  template<class T, class F>
-  void visit(Array<T,F>& o);
+  template<class T, class F, int64_t B>
+  void visit(Array<T,F,B>& o);
 
   template<class T>
   void visit(Inplace<T>& o);
@@ -58,8 +58,8 @@ public:
 #include "libbirch/Inplace.hpp"
 #include "libbirch/Shared.hpp"
 
-template<class T, class F>
-void libbirch::Destroyer::visit(Array<T,F>& o) {
+template<class T, class F, int64_t B>
+void libbirch::Destroyer::visit(Array<T,F,B>& o) {
   if (!std::is_trivially_copyable<T>::value) {
     auto iter = o.begin();
     auto last = o.end();
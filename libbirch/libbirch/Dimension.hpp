@@ -34,9 +34,11 @@ struct Dimension: public Length<length_value>, public Stride<stride_value> {
    * @param stride Initial stride.
    *
    * For static values, the initial values given must match the static values
-   * or an error is given.
+   * or an error is given. By default they do, so that a dimension with static
+   * length and stride may be default constructed.
    */
-  Dimension(const int64_t length = 0, const int64_t stride = 0) :
+  Dimension(const int64_t length = length_value,
+      const int64_t stride = stride_value) :
       length_type(length),
       stride_type(stride) {
     assert(length >= 0 && "length must be non-negative");
@@ -58,12 +60,14 @@ struct Dimension: public Length<length_value>, public Stride<stride_value> {
   }
 
   /**
-   * Slice operator.
+   * Slice operator. The stride of the result is always mutable, even if that
+   * of this dimension is static, as for a fixed shape, so that the shape of
+   * the resulting view can be compacted when it is copied.
    */
   template<int64_t offset_value1, int64_t length_value1>
   auto operator()(const Range<offset_value1,length_value1>& arg) const {
     static const int64_t new_length_value = length_value1;
-    static const int64_t new_stride_value = stride_value;
+    static const int64_t new_stride_value = mutable_value;
     return Dimension<new_length_value,new_stride_value>(arg.length, this->stride);
   }
 
@@ -21,16 +21,51 @@ using EigenMatrix = Eigen::Matrix<Type,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowM
 template<class Type>
 using EigenMatrixMap = Eigen::Map<EigenMatrix<Type>,Eigen::DontAlign,EigenMatrixStride>;
 
+template<class Type, int64_t n>
+using EigenFixedVector = Eigen::Matrix<Type,n,1,Eigen::ColMajor>;
+template<class Type, int64_t n>
+using EigenFixedVectorMap = Eigen::Map<EigenFixedVector<Type,n>,Eigen::DontAlign,EigenVectorStride>;
+
+template<class Type, int64_t r, int64_t c>
+using EigenFixedMatrix = Eigen::Matrix<Type,r,c,Eigen::RowMajor>;
+template<class Type, int64_t r, int64_t c>
+using EigenFixedMatrixMap = Eigen::Map<EigenFixedMatrix<Type,r,c>,Eigen::DontAlign,EigenMatrixStride>;
+
 /*
- * Eigen type for an array type.
+ * Eigen type for an array type. Arrays of fixed shape map to fixed-size
+ * Eigen types, so that Eigen can unroll operations on them, except for
+ * single-column matrices, which Eigen does not support in row-major order.
  */
-template<class ArrayType>
+template<class ArrayType, int D = ArrayType::shape_type::count(),
+    bool fixed = ArrayType::shape_type::fixed()>
 struct eigen_type {
-  using type = typename std::conditional<ArrayType::shape_type::count() == 2,
+  using type = void;
+};
+
+template<class ArrayType>
+struct eigen_type<ArrayType,1,false> {
+  using type = EigenVectorMap<typename ArrayType::value_type>;
+};
+
+template<class ArrayType>
+struct eigen_type<ArrayType,2,false> {
+  using type = EigenMatrixMap<typename ArrayType::value_type>;
+};
+
+template<class ArrayType>
+struct eigen_type<ArrayType,1,true> {
+  using type = EigenFixedVectorMap<typename ArrayType::value_type,
+      ArrayType::shape_type::head_type::length_value>;
+};
+
+template<class ArrayType>
+struct eigen_type<ArrayType,2,true> {
+  static const int64_t rows = ArrayType::shape_type::head_type::length_value;
+  static const int64_t cols =
+      ArrayType::shape_type::tail_type::head_type::length_value;
+  using type = typename std::conditional<cols == 1,
       EigenMatrixMap<typename ArrayType::value_type>,
-    typename std::conditional<ArrayType::shape_type::count() == 1,
-      EigenVectorMap<typename ArrayType::value_type>,
-    void>::type>::type;
+      EigenFixedMatrixMap<typename ArrayType::value_type,rows,cols>>::type;
 };
 
 template<class ArrayType>
@@ -50,7 +85,7 @@ struct is_eigen_compatible {
   static const bool value =
       std::is_same<typename ArrayType::value_type,typename EigenType::value_type>::value &&
           ((ArrayType::shape_type::count() == 1 && EigenType::ColsAtCompileTime == 1) ||
-           (ArrayType::shape_type::count() == 2 && EigenType::ColsAtCompileTime == Eigen::Dynamic));
+           (ArrayType::shape_type::count() == 2 && EigenType::ColsAtCompileTime != 1));
 };
 
 template<class ArrayType, class EigenType>
@@ -64,7 +99,7 @@ template<class ArrayType, class EigenType>
 struct is_triangle_compatible {
   static const bool value =
       std::is_same<typename ArrayType::value_type,typename EigenType::value_type>::value &&
-          ArrayType::shape_type::count() == 2 && EigenType::ColsAtCompileTime == Eigen::Dynamic;
+          ArrayType::shape_type::count() == 2 && EigenType::ColsAtCompileTime != 1;
 };
 
 }
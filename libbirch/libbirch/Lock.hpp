@@ -5,6 +5,9 @@
 
 #include "libbirch/external.hpp"
 #include "libbirch/Atomic.hpp"
+#include "libbirch/thread.hpp"
+
+#include <thread>
 
 namespace libbirch {
 /**
@@ -35,8 +38,24 @@ public:
    * Obtain exclusive use.
    */
   void set() {
-    /* spin, setting the lock true until its old value comes back false */
-    while (lock.exchangeLock(true));
+    /* test-and-test-and-set: only attempt to set the lock when it is observed
+     * to be unset, spinning otherwise on loads, which leave the cache line
+     * shared rather than taking exclusive ownership of it; between loads,
+     * back off exponentially, then yield once the backoff reaches its limit,
+     * so that a long wait does not occupy the processor */
+    int n = 1;
+    while (lock.exchangeLock(true)) {
+      do {
+        if (n <= MAX_BACKOFF) {
+          for (int i = 0; i < n; ++i) {
+            pause();
+          }
+          n *= 2;
+        } else {
+          std::this_thread::yield();
+        }
+      } while (lock.load());
+    }
   }
 
   /**
@@ -47,6 +66,12 @@ public:
   }
 
 private:
+  /**
+   * Maximum number of pauses between attempts to obtain the lock, before
+   * yielding instead.
+   */
+  static constexpr int MAX_BACKOFF = 1024;
+
   /**
    * Lock.
    */
@@ -0,0 +1,36 @@
+/**
+ * @file
+ */
+#include "libbirch/Serializer.hpp"
+
+#include <iostream>
+
+void libbirch::Serializer::visit(std::string& o) {
+  int64_t n = o.size();
+  visit(n);
+  write(o.data(), n);
+}
+
+void libbirch::Serializer::write(Any* o) {
+  auto result = indices.insert(std::make_pair(o, int64_t(indices.size())));
+  visit(result.first->second);
+  if (result.second) {
+    /* first reference, write the object itself */
+    auto key = o->getClassKey_();
+    if (!key) {
+      error(o->getClassName_());
+    }
+    std::string k = key;
+    visit(k);
+
+    /* results of bridge finding are preserved, so that objects beyond
+     * bridges can still be copied on use once restored */
+    visit(o->a_, o->k_, o->n_);
+    o->accept_(*this);
+  }
+}
+
+void libbirch::Serializer::error(const char* type) {
+  std::cerr << "error: cannot serialize a value of type " << type << std::endl;
+  std::exit(EXIT_FAILURE);
+}
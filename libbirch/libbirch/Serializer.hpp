@@ -0,0 +1,139 @@
+/**
+ * @file
+ */
+#pragma once
+
+#include "libbirch/external.hpp"
+#include "libbirch/internal.hpp"
+
+namespace libbirch {
+/**
+ * @internal
+ *
+ * Serialize a graph to bytes, for checkpointing. Each object is written
+ * once, along with the key of its class, see register_class(); further
+ * references to it are written as its index only, so that shared objects and
+ * cycles are restored as such by Deserializer. Bridge flags are preserved,
+ * so that lazy copies remain lazy once restored. The graph is read without
+ * copy-on-use, and so is not modified.
+ *
+ * @ingroup libbirch
+ *
+ * Values of trivially copyable types are written as they are, so that the
+ * bytes may only be read by the same program on the same platform. A graph
+ * containing values of other types without a visit() overload, such as
+ * lambdas, cannot be serialized; this is an error.
+ */
+class Serializer {
+public:
+  void visit() {
+    //
+  }
+
+  template<class Arg>
+  void visit(Arg& arg) {
+    if constexpr (std::is_trivially_copyable<Arg>::value) {
+      write(&arg, sizeof(Arg));
+    } else {
+      error(typeid(Arg).name());
+    }
+  }
+
+  template<class Arg, class... Args>
+  void visit(Arg& arg, Args&... args) {
+    visit(arg);
+    visit(args...);
+  }
+
+  template<class... Args>
+  void visit(std::tuple<Args...>& o) {
+    std::apply([&](Args&... args) { return visit(args...); }, o);
+  }
+
+  template<class T>
+  void visit(std::optional<T>& o) {
+    bool has = o.has_value();
+    visit(has);
+    if (has) {
+      visit(o.value());
+    }
+  }
+
+  void visit(std::string& o);
+
+  template<class T, class F, int64_t B>
+  void visit(Array<T,F,B>& o);
+
+  template<class T>
+  void visit(Inplace<T>& o);
+
+  template<class T>
+  void visit(Shared<T>& o);
+
+  /**
+   * Serialized bytes.
+   */
+  std::vector<char>& data() {
+    return bytes;
+  }
+
+private:
+  /**
+   * Write bytes.
+   */
+  void write(const void* ptr, const size_t n) {
+    auto from = static_cast<const char*>(ptr);
+    bytes.insert(bytes.end(), from, from + n);
+  }
+
+  /**
+   * Write an object, or its index if already written.
+   */
+  void write(Any* o);
+
+  /**
+   * Report a value that cannot be serialized, and exit.
+   */
+  [[noreturn]] static void error(const char* type);
+
+  /**
+   * Serialized bytes.
+   */
+  std::vector<char> bytes;
+
+  /**
+   * Indices of objects already written.
+   */
+  std::unordered_map<Any*,int64_t> indices;
+};
+}
+
+#include "libbirch/Array.hpp"
+#include "libbirch/Inplace.hpp"
+#include "libbirch/Shared.hpp"
+#include "libbirch/Any.hpp"
+
+template<class T, class F, int64_t B>
+void libbirch::Serializer::visit(Array<T,F,B>& o) {
+  if constexpr (!Array<T,F,B>::isFixed) {
+    int64_t rows = o.rows(), cols = o.cols();
+    visit(rows, cols);
+  }
+  auto iter = o.begin();
+  auto last = o.end();
+  for (; iter != last; ++iter) {
+    visit(*iter);
+  }
+}
+
+template<class T>
+void libbirch::Serializer::visit(Inplace<T>& o) {
+  return o->accept_(*this);
+}
+
+template<class T>
+void libbirch::Serializer::visit(Shared<T>& o) {
+  bool b = o.b;
+  visit(b);
+  write(o.load());
+}
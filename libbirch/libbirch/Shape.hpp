@@ -72,6 +72,14 @@ struct EmptyShape {
     return 0;
   }
 
+  static constexpr bool fixed() {
+    return true;
+  }
+
+  static constexpr int64_t fixed_volume() {
+    return 1;
+  }
+
   static constexpr int64_t size() {
     return 1;
   }
@@ -101,8 +109,12 @@ struct EmptyShape {
  */
 template<class Head, class Tail>
 struct Shape {
+  typedef Head head_type;
+  typedef Tail tail_type;
+
   /**
-   * Default constructor (for zero-size shape).
+   * Default constructor (for zero-size shape, or for a fixed shape, that
+   * shape).
    */
   Shape() {
     //
@@ -132,6 +144,16 @@ struct Shape {
    */
   Shape(const Shape<Head,Tail>& o) = default;
 
+  /**
+   * Generic copy constructor.
+   */
+  template<class Head1, class Tail1>
+  Shape(const Shape<Head1,Tail1>& o) :
+      head(o.head),
+      tail(o.tail) {
+    //
+  }
+
   /**
    * Slice operator.
    */
@@ -245,6 +267,22 @@ struct Shape {
     return 1 + Tail::count();
   }
 
+  /**
+   * Are all lengths and strides static? An array of fixed shape has a volume
+   * known at compile time.
+   */
+  static constexpr bool fixed() {
+    return Head::length_value != mutable_value &&
+        Head::stride_value != mutable_value && Tail::fixed();
+  }
+
+  /**
+   * Product of all strides, for a fixed shape.
+   */
+  static constexpr int64_t fixed_volume() {
+    return Head::length_value*Head::stride_value;
+  }
+
   /**
    * Product of all lengths.
    */
@@ -293,6 +331,23 @@ struct DefaultShape<0> {
   typedef EmptyShape type;
 };
 
+/**
+ * Fixed shape with lengths `n...`, stored contiguously in row-major order.
+ */
+template<int64_t... n>
+struct FixedShape;
+template<int64_t n, int64_t... m>
+struct FixedShape<n,m...> {
+  static const int64_t volume = n*FixedShape<m...>::volume;
+  typedef Shape<Dimension<n,FixedShape<m...>::volume>,
+      typename FixedShape<m...>::type> type;
+};
+template<>
+struct FixedShape<> {
+  static const int64_t volume = 1;
+  typedef EmptyShape type;
+};
+
 /**
  * Make a shape, no arguments.
  *
@@ -7,6 +7,7 @@
 #include "libbirch/Atomic.hpp"
 #include "libbirch/type.hpp"
 #include "libbirch/memory.hpp"
+#include "libbirch/thread.hpp"
 
 namespace libbirch {
 /**
@@ -38,9 +39,12 @@ class Shared {
   friend class BiconnectedCollector;
   friend class Spanner;
   friend class Bridger;
+  friend class BridgeFlag;
   friend class Copier;
   friend class BiconnectedCopier;
   friend class Destroyer;
+  friend class Serializer;
+  friend class Deserializer;
 public:
   using value_type = T;
 
@@ -483,8 +487,21 @@ T* libbirch::Shared<T>::get() {
 
 template<class T>
 void libbirch::Shared<T>::bridge() {
-  Spanner().visit(0, 1, *this);
-  Bridger().visit(1, 0, *this);
+  /* for large graphs, with multiple threads, parts of the search are
+   * deferred and run in parallel, see Spanner */
+  Spanner spanner(get_max_threads() > 1);
+  Bridger bridger(!spanner.isDeferring());
+  spanner.visit(0, 1, *this);
+  bridger.visit(1, 0, *this);
+  if (spanner.isDeferring()) {
+    bool success = spanner.visitDeferred(bridger);
+    spanner.release();
+    if (!success) {
+      bridger.reset();
+      Spanner().visit(0, 1, *this);
+      Bridger().visit(1, 0, *this);
+    }
+  }
 }
 
 template<class T>
@@ -3,10 +3,88 @@
  */
 #include "libbirch/Spanner.hpp"
 
+#include "libbirch/Bridger.hpp"
+#include "libbirch/thread.hpp"
+
+libbirch::Spanner::Spanner(const bool defer) :
+    n(defer ? MAX_CLAIMS : std::numeric_limits<int>::max()),
+    deferring(defer),
+    conflict(false) {
+  //
+}
+
+bool libbirch::Spanner::visitDeferred(Bridger& bridger) {
+  Atomic<bool> success(true);
+  if (!deferred.empty()) {
+    /* an object of this search with references that it did not follow may
+     * be referenced from the deferred objects, which the second pass did not
+     * account for */
+    if (bridger.hasExternal()) {
+      success.store(false);
+    }
+
+    parallel_for(0, deferred.size() - 1, [&](const int64_t i) {
+      Any* o = deferred[i].first;
+      BridgeFlag& b = deferred[i].second;
+      o->f_.maskAnd(~CLAIMED);  // release claim made when deferred
+
+      Spanner spanner(true);
+      Bridger bridger1(false);
+      int l, h, m, n;
+      spanner.visit(0, 1, o);
+      std::tie(l, h, m, n) = bridger1.visit(1, 0, o);
+
+      /* nested searches run regardless, as their claims must be released */
+      bool success1 = spanner.visitDeferred(bridger1);
+
+      /* reaching an object claimed by another search means an edge to
+       * objects numbered by that search, which this one did not account
+       * for, e.g. back to objects of the search that deferred this one;
+       * otherwise the test is as in Bridger::visit(Shared<T>&) */
+      if (success1 && !spanner.conflict && l == 1 && h < 1 + m) {
+        b.set(true);
+        bridger1.add(b);
+      } else {
+        success.store(false);
+      }
+
+      lock.set();
+      claimed.insert(claimed.end(), spanner.claimed.begin(),
+          spanner.claimed.end());
+      bridger.splice(bridger1);
+      lock.unset();
+    }, true);
+    deferred.clear();
+  }
+  return success.load();
+}
+
+void libbirch::Spanner::release() {
+  for (auto o : claimed) {
+    o->f_.maskAnd(~CLAIMED);
+  }
+  claimed.clear();
+}
+
+bool libbirch::Spanner::defer(Any* o, const BridgeFlag& b) {
+  if (n == 0 && !(o->f_.exchangeOr(CLAIMED) & CLAIMED)) {
+    /* p_ is not set, so the remainder of this search treats the object as
+     * claimed by a different thread */
+    deferred.push_back(std::make_pair(o, b));
+    return true;
+  } else {
+    return false;
+  }
+}
+
 std::tuple<int,int,int> libbirch::Spanner::visit(const int i, const int j,
     Any* o) {
   if (!(o->f_.exchangeOr(CLAIMED) & CLAIMED)) {
     /* just claimed by this thread */
+    if (deferring) {
+      claimed.push_back(o);
+      --n;
+    }
     assert(o->p_ == -1);
     o->p_ = get_thread_num();
     o->a_ = 1;
@@ -25,6 +103,9 @@ std::tuple<int,int,int> libbirch::Spanner::visit(const int i, const int j,
     return std::make_tuple(o->l_, o->h_, 0);
   } else {
     /* claimed by a different thread */
+    if (deferring) {
+      conflict = true;
+    }
     return std::make_tuple(i, i, 0);
   }
 }
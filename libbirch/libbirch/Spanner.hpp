@@ -5,6 +5,8 @@
 
 #include "libbirch/external.hpp"
 #include "libbirch/internal.hpp"
+#include "libbirch/BridgeFlag.hpp"
+#include "libbirch/Lock.hpp"
 
 namespace libbirch {
 /**
@@ -13,9 +15,64 @@ namespace libbirch {
  * Visitor implementing the first pass of bridge finding.
  *
  * @ingroup libbirch
+ *
+ * To find bridges in large graphs in parallel, the visitor may defer
+ * objects once it has claimed a number of them. Each deferred object then
+ * roots a separate search, run in parallel by visitDeferred(), and these may
+ * defer objects in turn. A separate search succeeds if it finds that its
+ * object is reachable only through the edge by which it was deferred, which
+ * is then a bridge. Claims are held until all searches have finished, so
+ * that each object is numbered by exactly one search. If any search fails,
+ * the numbering of some biconnected component is incomplete, and the whole
+ * must be repeated without deferral.
+ *
+ * Each search sees only the edges within its own objects, so must also fail
+ * where an edge crosses between searches. A separate search fails if it
+ * reaches an object claimed by another search, e.g. by an edge back into the
+ * objects of the search that deferred it. A search that deferred objects
+ * fails if any of its own objects has more references than the edges that
+ * it followed to them, as the remainder may be from the deferred objects.
  */
 class Spanner {
 public:
+  /**
+   * Number of objects to claim before deferring.
+   */
+  static constexpr int MAX_CLAIMS = 1 << 16;
+
+  /**
+   * Constructor.
+   *
+   * @param defer Defer objects beyond the first MAX_CLAIMS?
+   */
+  explicit Spanner(const bool defer = false);
+
+  /**
+   * Is this visitor deferring objects? If so, its claims are held until
+   * release(), rather than released by Bridger.
+   */
+  bool isDeferring() const {
+    return deferring;
+  }
+
+  /**
+   * Run the separate searches for deferred objects. Must be called after the
+   * second pass.
+   *
+   * @param bridger The visitor used for the second pass. Bridges found by
+   * the separate searches are added to it, see Bridger::reset().
+   *
+   * @return Did all separate searches succeed, and were there no edges
+   * from them back into the objects of this search?
+   */
+  bool visitDeferred(Bridger& bridger);
+
+  /**
+   * Release the claims held by this visitor, including those of the
+   * separate searches of visitDeferred().
+   */
+  void release();
+
   std::tuple<int,int,int> visit(const int i, const int j) {
     return std::make_tuple(i, i, 0);
   }
@@ -50,8 +107,8 @@ public:
     }
   }
 
-  template<class T, class F>
-  std::tuple<int,int,int> visit(const int i, const int j, Array<T,F>& o);
+  template<class T, class F, int64_t B>
+  std::tuple<int,int,int> visit(const int i, const int j, Array<T,F,B>& o);
 
   template<class T>
   std::tuple<int,int,int> visit(const int i, const int j, Inplace<T>& o);
@@ -60,6 +117,48 @@ public:
   std::tuple<int,int,int> visit(const int i, const int j, Shared<T>& o);
 
   std::tuple<int,int,int> visit(const int i, const int j, Any* o);
+
+private:
+  /**
+   * Defer an object, if enough objects have been claimed already.
+   *
+   * @param o The object.
+   * @param b Bridge flag of the edge to the object.
+   *
+   * @return Was the object deferred?
+   */
+  bool defer(Any* o, const BridgeFlag& b);
+
+  /**
+   * Deferred objects, with the bridge flags of the edges to them.
+   */
+  std::vector<std::pair<Any*,BridgeFlag>> deferred;
+
+  /**
+   * Claimed objects, when deferring.
+   */
+  std::vector<Any*> claimed;
+
+  /**
+   * Lock for adding to claimed from separate searches.
+   */
+  Lock lock;
+
+  /**
+   * Number of objects that may still be claimed before deferring.
+   */
+  int n;
+
+  /**
+   * Is this visitor deferring objects?
+   */
+  bool deferring;
+
+  /**
+   * When deferring, has this visitor reached an object claimed by another
+   * search?
+   */
+  bool conflict;
 };
 }
 
@@ -68,9 +167,9 @@ public:
 #include "libbirch/Shared.hpp"
 #include "libbirch/Any.hpp"
 
-template<class T, class F>
+template<class T, class F, int64_t B>
 std::tuple<int,int,int> libbirch::Spanner::visit(const int i, const int j,
-    Array<T,F>& o) {
+    Array<T,F,B>& o) {
   int l = i, h = i, m = 0, l1, h1, m1;
   if (!std::is_trivially_copyable<T>::value) {
     auto iter = o.begin();
@@ -96,7 +195,12 @@ std::tuple<int,int,int> libbirch::Spanner::visit(const int i, const int j,
     Shared<T>& o) {
   if (!o.b) {
     Any* o1 = o.load();
-    return visit(i, j, o1);
+    if (defer(o1, BridgeFlag(o))) {
+      /* as for an object claimed by a different thread */
+      return std::make_tuple(i, i, 0);
+    } else {
+      return visit(i, j, o1);
+    }
   } else {
     return std::make_tuple(i, i, 0);
   }
@@ -13,6 +13,10 @@
 #include <optional>
 #include <memory>
 #include <initializer_list>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <typeinfo>
 
 #include <cassert>
 #include <cstdlib>
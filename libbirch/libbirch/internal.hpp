@@ -6,7 +6,7 @@
 #pragma once
 
 namespace libbirch {
-template<class T, class F> class Array;
+template<class T, class F, int64_t B = 64> class Array;
 template<class T> class Inplace;
 template<class T> class Shared;
 class Any;
@@ -17,9 +17,12 @@ class Collector;
 class BiconnectedCollector;
 class Spanner;
 class Bridger;
+class BridgeFlag;
 class Copier;
 class Memo;
 class BiconnectedCopier;
 class BiconnectedMemo;
 class Destroyer;
+class Serializer;
+class Deserializer;
 }
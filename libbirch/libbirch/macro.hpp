@@ -36,7 +36,10 @@
  *
  * @def LIBBIRCH_VIRTUAL
  *
- * Declare virtual functions for concrete classes.
+ * Declare virtual functions for concrete classes. This also registers the
+ * class for deserialization; the registration is instantiated with the
+ * virtual functions, so that it occurs for every instantiation of a generic
+ * class that is used.
  */
 #define LIBBIRCH_VIRTUAL(Name, Base...) \
   virtual const char* getClassName_() const override { \
@@ -45,6 +48,12 @@
   \
   virtual Name* copy_() const override { \
     return new Name(*this); \
+  } \
+  \
+  static inline const char* const key_ = libbirch::register_class<Name>(); \
+  \
+  virtual const char* getClassKey_() const override { \
+    return key_; \
   }
 
 /**
@@ -67,15 +76,32 @@
  *       LIBBIRCH_CLASS_MEMBERS(x, y, z)
  *     };
  *
+ * The class must also have a deserialization constructor, which reads the
+ * same members in the same order, e.g.:
+ *
+ *     A(libbirch::Deserializer& visitor_) :
+ *         B(visitor_),
+ *         x(visitor_.read<int>()),
+ *         y(visitor_.read<int>()),
+ *         z(visitor_.read<int>()) {
+ *       //
+ *     }
+ *
  * The use of a variadic macro here supports base classes that contain
  * commas without special treatment, e.g.
  *
  *     LIBBIRCH_CLASS(A, B<T,U>)
+ *
+ * A class declared with LIBBIRCH_CLASS is never acyclic, even if its base
+ * class is, as it may add members that introduce cycles.
  */
 #define LIBBIRCH_CLASS(Name, Base...) \
   LIBBIRCH_THIS(Name) \
   LIBBIRCH_BASE(Base) \
-  LIBBIRCH_VIRTUAL(Name, Base)
+  LIBBIRCH_VIRTUAL(Name, Base) \
+  virtual bool isAcyclic_() const override { \
+    return false; \
+  }
 
 /**
  * @def LIBBIRCH_ACYCLIC_CLASS
@@ -178,6 +204,11 @@
   void accept_(libbirch::Destroyer& visitor_) override { \
     base_type_::accept_(visitor_); \
     visitor_.visit(__VA_ARGS__); \
+  } \
+  \
+  void accept_(libbirch::Serializer& visitor_) override { \
+    base_type_::accept_(visitor_); \
+    visitor_.visit(__VA_ARGS__); \
   }
 
 /**
@@ -224,6 +255,10 @@
   \
   void accept_(libbirch::Destroyer& visitor_) override { \
     return base_type_::accept_(visitor_); \
+  } \
+  \
+  void accept_(libbirch::Serializer& visitor_) override { \
+    return base_type_::accept_(visitor_); \
   }
 
 /**
@@ -234,7 +269,8 @@
  * arguments.
  *
  * LIBBIRCH_STRUCT must be followed by LIBBIRCH_STRUCT_MEMBERS, and should be
- * in a public section.
+ * in a public section. As for LIBBIRCH_CLASS, the struct must also have a
+ * deserialization constructor.
  */
 #define LIBBIRCH_STRUCT(Name)
 
@@ -286,6 +322,10 @@
   \
   void accept_(libbirch::Destroyer& visitor_) { \
     visitor_.visit(__VA_ARGS__); \
+  } \
+  \
+  void accept_(libbirch::Serializer& visitor_) { \
+    visitor_.visit(__VA_ARGS__); \
   }
 
 /**
@@ -310,7 +350,8 @@
   \
   void accept_(libbirch::Copier& visitor_) {} \
   void accept_(libbirch::BiconnectedCopier& visitor_) {} \
-  void accept_(libbirch::Destroyer& visitor_) {}
+  void accept_(libbirch::Destroyer& visitor_) {} \
+  void accept_(libbirch::Serializer& visitor_) {}
 
 #include "libbirch/Marker.hpp"
 #include "libbirch/Scanner.hpp"
@@ -322,3 +363,5 @@
 #include "libbirch/Copier.hpp"
 #include "libbirch/BiconnectedCopier.hpp"
 #include "libbirch/Destroyer.hpp"
+#include "libbirch/Serializer.hpp"
+#include "libbirch/Deserializer.hpp"
@@ -27,6 +27,18 @@ static thread_local std::vector<libbirch::Any*> unreachables;
  */
 static thread_local bool biconnected_flag = false;
 
+/**
+ * Last owner id assigned.
+ */
+static libbirch::Atomic<int> owner_ids(0);
+
+thread_local int libbirch::owner_id = 0;
+
+int libbirch::assign_owner_id() {
+  owner_id = ++owner_ids;
+  return owner_id;
+}
+
 void libbirch::register_possible_root(Any* o) {
   possible_roots.push_back(o);
 }
@@ -72,7 +84,13 @@ void libbirch::collect() {
     int size = 0;
     for (int i = 0; i < (int)possible_roots.size(); ++i) {
       auto o = possible_roots[i];
-      if (o->numShared_() == 0) {
+      if (o->unbias_() == 0) {
+        /* last reference released by a thread other than the owner, merging
+         * the biased count reveals it; kept as a possible root, so that the
+         * passes below release its references, and collect it, as for any
+         * other unreachable object */
+        possible_roots[size++] = o;
+      } else if (o->numShared_() == 0) {
         o->deallocate_();  // deallocation was deferred until now
       } else if (o->isPossibleRoot_()) {
         possible_roots[size++] = o;
@@ -161,10 +179,11 @@ void libbirch::collect() {
       o->destroy_();
       o->deallocate_();
     }
-  }
 
-  assert(possible_roots.empty());
-  assert(unreachables.empty());
+    /* the lists of every thread must be empty now */
+    assert(possible_roots.empty());
+    assert(unreachables.empty());
+  }
 }
 
 bool libbirch::biconnected_copy(const bool toggle) {
@@ -7,6 +7,26 @@
 #include "libbirch/internal.hpp"
 
 namespace libbirch {
+/**
+ * Owner id of this thread, zero if not yet assigned.
+ */
+extern thread_local int owner_id;
+
+/**
+ * Assign an owner id to this thread.
+ */
+int assign_owner_id();
+
+/**
+ * Owner id of this thread. Objects record the id of the thread that created
+ * them, and bias their reference count toward that thread. Unlike the thread
+ * number of get_thread_num(), the id is unique among all threads, including
+ * those of nested parallel regions.
+ */
+inline int get_owner_id() {
+  return owner_id ? owner_id : assign_owner_id();
+}
+
 /**
  * Register an object with the cycle collector as the possible root of a
  * cycle. This corresponds to the `PossibleRoot()` operation in @ref Bacon2001
@@ -5,6 +5,10 @@
 
 #include "libbirch/external.hpp"
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
 namespace libbirch {
 /**
  * Get the maximum number of threads.
@@ -32,4 +36,85 @@ inline int get_thread_num() {
 #endif
 }
 
+/**
+ * Execute the iterations of a loop in parallel.
+ *
+ * @ingroup libbirch
+ *
+ * @tparam F Function type.
+ *
+ * @param from First index.
+ * @param to Last index (inclusive).
+ * @param f Function, taking the index.
+ * @param dynamic Are iterations expected to vary in cost? If so, each is a
+ * separate task, otherwise the loop is divided into one task per thread.
+ *
+ * The iterations are executed as tasks by the persistent thread pool of the
+ * OpenMP runtime, which distributes them by work stealing. When called
+ * outside of a parallel region, a new region is entered for the loop. When
+ * called within one, such as from an iteration of an outer loop, the tasks
+ * are added to those of the enclosing region instead, and its threads
+ * execute them as they become idle, so that nested loops are also executed
+ * in parallel, without starting more threads. The call returns once all
+ * iterations have completed; meanwhile the calling thread executes tasks too.
+ * Any iteration may therefore execute on any thread, including those of a
+ * nested loop, some of which the thread that calls it executes before
+ * continuing with its own iteration of the outer loop. Thread-local state,
+ * such as the pseudorandom number generator of each thread, must be set at
+ * the start of each iteration if results are to be reproducible.
+ *
+ * The exception is a loop that is not dynamic and not nested. Its iterations
+ * are divided evenly between the threads, in order, so that two such loops
+ * over the same range assign each index to the same thread. Memory first
+ * touched by one loop, e.g. to construct the particles of a particle filter,
+ * is then local to the thread that accesses it in the next, which matters on
+ * NUMA systems when threads are bound to cores (e.g. `OMP_PROC_BIND`).
+ */
+template<class F>
+void parallel_for(const int64_t from, const int64_t to, const F& f,
+    const bool dynamic = false) {
+#ifdef _OPENMP
+  if (!omp_in_parallel() && !dynamic) {
+    #pragma omp parallel for schedule(static)
+    for (int64_t i = from; i <= to; ++i) {
+      f(i);
+    }
+  } else if (!omp_in_parallel()) {
+    #pragma omp parallel
+    {
+      #pragma omp single
+      parallel_for(from, to, f, dynamic);
+    }
+  } else if (dynamic) {
+    #pragma omp taskloop grainsize(1)
+    for (int64_t i = from; i <= to; ++i) {
+      f(i);
+    }
+  } else {
+    #pragma omp taskloop num_tasks(omp_get_num_threads())
+    for (int64_t i = from; i <= to; ++i) {
+      f(i);
+    }
+  }
+#else
+  for (int64_t i = from; i <= to; ++i) {
+    f(i);
+  }
+#endif
+}
+
+/**
+ * Hint to the processor that the current thread is spinning, e.g. while
+ * waiting on a lock.
+ *
+ * @ingroup libbirch
+ */
+inline void pause() {
+#if defined(__x86_64__) || defined(__i386__)
+  _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  __asm__ __volatile__("yield");
+#endif
+}
+
 }
@@ -0,0 +1,148 @@
+/**
+ * @file
+ *
+ * Tests of libbirch::Array, in particular of the transitions of its
+ * elements between the small buffer and the heap.
+ */
+#include "libbirch/libbirch.hpp"
+
+#include <iostream>
+#include <string>
+
+using namespace libbirch;
+
+/**
+ * Vector of Real, with a small buffer of eight elements.
+ */
+using Vector = DefaultArray<double,1>;
+
+/**
+ * Are the elements of an array stored inline, in the small buffer?
+ */
+template<class T, class F, int64_t B>
+bool isInline(const Array<T,F,B>& x) {
+  auto p = reinterpret_cast<const char*>(&*x.begin());
+  auto q = reinterpret_cast<const char*>(&x);
+  return q <= p && p < q + sizeof(x);
+}
+
+/**
+ * Does a vector contain the values 1 to n?
+ */
+bool check(const Vector& x, const int64_t n) {
+  if (x.size() != n) {
+    return false;
+  }
+  for (int64_t i = 1; i <= n; ++i) {
+    if (x(i) != double(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Vector with the values 1 to n.
+ */
+Vector iota(const int64_t n) {
+  Vector x;
+  for (int64_t i = 1; i <= n; ++i) {
+    x.push(double(i));
+  }
+  return x;
+}
+
+/**
+ * Report a failure and exit.
+ */
+void fail(const std::string& msg) {
+  std::cerr << msg << std::endl;
+  std::exit(1);
+}
+
+int main() {
+  const int64_t capacity = Vector::capacity;
+  if (capacity != 8) {
+    fail("unexpected small buffer capacity");
+  }
+
+  /* push past the capacity of the small buffer */
+  Vector x;
+  for (int64_t n = 1; n <= 2*capacity; ++n) {
+    x.push(double(n));
+    if (!check(x, n)) {
+      fail("push of element " + std::to_string(n) + " failed");
+    }
+    if (isInline(x) != (n <= capacity)) {
+      fail("push of element " + std::to_string(n) + " used wrong buffer");
+    }
+  }
+
+  /* insert and erase within the small buffer */
+  Vector y = iota(4);
+  y.insert(0, 0.0);
+  y.erase(0);
+  if (!check(y, 4) || !isInline(y)) {
+    fail("insert or erase in small buffer failed");
+  }
+
+  /* a copy of a small array is a copy into the small buffer, even if the
+   * original is on the heap */
+  Vector z = iota(capacity);
+  Vector z1(z);
+  z1(1) = 0.0;
+  if (!check(z, capacity) || z1(1) != 0.0 || !isInline(z1)) {
+    fail("copy of small array failed");
+  }
+  Vector w = iota(2*capacity);
+  w.erase(capacity, capacity);
+  Vector w1(w);
+  if (isInline(w) || !check(w1, capacity) || !isInline(w1)) {
+    fail("copy of small array on heap failed");
+  }
+
+  /* a copy of a large array, not yet written element-wise, is shared until
+   * written, at which point the written copy is elementized, copying it to
+   * a new buffer */
+  Vector v([](int64_t i) { return double(i + 1); }, make_shape(2*capacity));
+  Vector v1(v);
+  if (&*std::as_const(v).begin() != &*std::as_const(v1).begin()) {
+    fail("copy of large array is not shared");
+  }
+  v1(1) = 0.0;
+  if (!check(v, 2*capacity) || v1(1) != 0.0 || v1(2) != 2.0 ||
+      isInline(v1)) {
+    fail("elementize of shared array failed");
+  }
+
+  /* move and swap (via move assignment) between the small buffer and the
+   * heap */
+  Vector a = iota(3), b = iota(2*capacity);
+  Vector c(std::move(a));
+  if (!check(c, 3) || !isInline(c)) {
+    fail("move of small array failed");
+  }
+  c = std::move(b);
+  if (!check(c, 2*capacity) || isInline(c) || !check(b, 3) || !isInline(b)) {
+    fail("swap of small and large arrays failed");
+  }
+  b = std::move(c);
+  if (!check(b, 2*capacity) || !check(c, 3) || !isInline(c)) {
+    fail("swap of large and small arrays failed");
+  }
+
+  /* vectors of vectors, which must not be relocated with realloc(), as each
+   * element may point into its own small buffer */
+  DefaultArray<Vector,1> X;
+  for (int64_t n = 1; n <= 2*capacity; ++n) {
+    X.push(iota(n));
+  }
+  X.insert(0, iota(1));
+  X.erase(0);
+  for (int64_t n = 1; n <= 2*capacity; ++n) {
+    if (!check(X(n), n) || isInline(X(n)) != (n <= capacity)) {
+      fail("vector of vectors failed");
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file
+ *
+ * Tests of bridge finding, in particular of the separate searches that
+ * libbirch::Spanner defers for large graphs, followed by lazy copies.
+ */
+#include "libbirch/libbirch.hpp"
+
+#include <iostream>
+#include <string>
+#include <pthread.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace libbirch;
+
+/**
+ * Number of objects alive.
+ */
+static Atomic<int> live(0);
+
+/**
+ * Node of a linked list.
+ */
+class Node : public Any {
+public:
+  LIBBIRCH_CLASS(Node, Any)
+  LIBBIRCH_CLASS_MEMBERS(next, value)
+
+  Node(const int value = 0) : value(value) {
+    ++live;
+  }
+
+  Node(const Node& o) : Any(o), next(o.next), value(o.value) {
+    ++live;
+  }
+
+  Node(Deserializer& visitor_) :
+      Any(visitor_),
+      next(visitor_.read<std::optional<Shared<Node>>>()),
+      value(visitor_.read<int>()) {
+    ++live;
+  }
+
+  ~Node() {
+    --live;
+  }
+
+  std::optional<Shared<Node>> next;
+  int value;
+};
+
+/**
+ * Report a failure and exit.
+ */
+void fail(const std::string& msg) {
+  std::cerr << msg << std::endl;
+  std::exit(1);
+}
+
+/**
+ * Follow a number of edges from a node.
+ */
+Node* follow(Node* o, const int n) {
+  for (int i = 0; i < n; ++i) {
+    o = o->next.value().get();
+  }
+  return o;
+}
+
+/**
+ * Run the tests. The searches and copies recurse along the chain, so this
+ * is run on a thread with a larger stack than the default.
+ */
+void* run(void*) {
+  /* the separate searches of Spanner are used only with multiple threads */
+  #ifdef _OPENMP
+  omp_set_dynamic(0);
+  omp_set_num_threads(4);
+  #endif
+
+  /* a chain of N_0 to N_L, longer than the number of objects that the first
+   * search claims before deferring the remainder, with a back edge from N_L
+   * to N_K; the edges from N_0 to N_K are bridges, the remainder form a
+   * single biconnected component, which spans the first search and those
+   * that it defers */
+  const int K = 100, L = Spanner::MAX_CLAIMS + 4464;
+  {
+    Shared<Node> x(std::in_place, 0);
+    Node* o = x.get();
+    Node* back = nullptr;
+    for (int i = 1; i <= L; ++i) {
+      o->next = Shared<Node>(std::in_place, i);
+      o = o->next.value().get();
+      if (i == K) {
+        back = o;
+      }
+    }
+    o->next = Shared<Node>(back);
+
+    x.bridge();
+    Shared<Node> y = x.copy();
+
+    /* modify the original, so that the copy must be a copy */
+    Node* x_K = follow(x.get(), K);
+    x_K->value = -1;
+
+    Node* y_K = follow(y.get(), K);
+    Node* y_L = follow(y_K, L - K);
+    Node* y_back = y_L->next.value().get();
+    if (y_K == x_K || y_K->value != K || y_L->value != L) {
+      fail("copy of chain failed");
+    }
+    if (y_back != y_K) {
+      fail("back edge of copy does not point to the copy of N_" +
+          std::to_string(K));
+    }
+
+    /* break the cycles, so that release does not depend on collect() */
+    follow(x.get(), L)->next.reset();
+    y_L->next.reset();
+  }
+  collect();
+  if (live.load() != 0) {
+    fail("chain test left " + std::to_string(live.load()) + " objects alive");
+  }
+  return nullptr;
+}
+
+int main() {
+  #ifndef _OPENMP
+  return 77;  // skipped, as multiple threads are needed
+  #endif
+  pthread_attr_t attr;
+  pthread_t thread;
+  pthread_attr_init(&attr);
+  pthread_attr_setstacksize(&attr, size_t(1) << 30);
+  if (pthread_create(&thread, &attr, run, nullptr) != 0) {
+    fail("could not create thread");
+  }
+  pthread_join(thread, nullptr);
+  pthread_attr_destroy(&attr);
+  return 0;
+}
@@ -0,0 +1,211 @@
+/**
+ * @file
+ *
+ * Tests of libbirch::Serializer and libbirch::Deserializer, which must
+ * restore a graph with the same structure, including cycles, shared objects
+ * and bridges, and reject truncated input.
+ */
+#include "libbirch/libbirch.hpp"
+
+#include <iostream>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace libbirch;
+
+/**
+ * Node of a graph.
+ */
+class Node : public Any {
+public:
+  LIBBIRCH_CLASS(Node, Any)
+  LIBBIRCH_CLASS_MEMBERS(next, other, value, name)
+
+  Node(const int value = 0) : value(value), name(std::to_string(value)) {
+    //
+  }
+
+  Node(const Node& o) = default;
+
+  Node(Deserializer& visitor_) :
+      Any(visitor_),
+      next(visitor_.read<std::optional<Shared<Node>>>()),
+      other(visitor_.read<std::optional<Shared<Node>>>()),
+      value(visitor_.read<int>()),
+      name(visitor_.read<std::string>()) {
+    //
+  }
+
+  std::optional<Shared<Node>> next;
+  std::optional<Shared<Node>> other;
+  int value;
+  std::string name;
+};
+
+/**
+ * Report a failure and exit.
+ */
+void fail(const std::string& msg) {
+  std::cerr << msg << std::endl;
+  std::exit(1);
+}
+
+/**
+ * Serialize a graph.
+ */
+std::vector<char> serialize(Shared<Node>& x) {
+  Serializer serializer;
+  serializer.visit(x);
+  return serializer.data();
+}
+
+/**
+ * Deserialize a graph, checking that all bytes are read.
+ */
+Shared<Node> deserialize(const std::vector<char>& bytes) {
+  Deserializer deserializer(bytes.data(), bytes.size());
+  auto x = deserializer.read<Shared<Node>>();
+  if (!deserializer.empty()) {
+    fail("not all bytes read");
+  }
+  return x;
+}
+
+/**
+ * Follow the next edges from a node.
+ */
+Node* follow(Node* o, const int n) {
+  for (int i = 0; i < n; ++i) {
+    o = o->next.value().get();
+  }
+  return o;
+}
+
+/**
+ * Make a cycle of n nodes, numbered 1 to n, with the other edge of the
+ * first node to a single node numbered 0 that is shared by the others.
+ */
+Shared<Node> make_cycle(const int n) {
+  Shared<Node> x(std::in_place, 1), shared(std::in_place, 0);
+  Node* o = x.get();
+  for (int i = 2; i <= n; ++i) {
+    o->next = Shared<Node>(std::in_place, i);
+    o = o->next.value().get();
+    o->other = shared;
+  }
+  o->next = x;
+  x.get()->other = shared;
+  return x;
+}
+
+/**
+ * Check a cycle made by make_cycle().
+ */
+bool check_cycle(Node* o, const int n) {
+  Node* shared = o->other.value().get();
+  if (shared->value != 0 || shared->name != "0") {
+    return false;
+  }
+  for (int i = 1; i <= n; ++i) {
+    if (o->value != i || o->name != std::to_string(i) ||
+        o->other.value().get() != shared) {
+      return false;
+    }
+    o = o->next.value().get();
+  }
+  return o->value == 1;
+}
+
+int main() {
+  /* truncated input is an error, and not a crash, nor a partial graph; as
+   * the error exits, each truncation is tried in a child process, before
+   * any other threads are started */
+  {
+    auto x = make_cycle(3);
+    auto bytes = serialize(x);
+    for (size_t n = 0; n < bytes.size(); ++n) {
+      pid_t pid = fork();
+      if (pid == 0) {
+        std::cerr.setstate(std::ios::failbit);  // silence expected errors
+        Deserializer deserializer(bytes.data(), n);
+        deserializer.read<Shared<Node>>();
+        _exit(0);
+      }
+      int status;
+      waitpid(pid, &status, 0);
+      if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_FAILURE) {
+        fail("truncation to " + std::to_string(n) + " of " +
+            std::to_string(bytes.size()) + " bytes not rejected");
+      }
+    }
+  }
+
+  /* a cycle, with a node shared by all others, is restored as such */
+  {
+    auto x = make_cycle(5);
+    auto y = deserialize(serialize(x));
+    if (y.get() == x.get() || !check_cycle(y.get(), 5)) {
+      fail("round trip of cycle failed");
+    }
+    if (follow(y.get(), 5) != y.get()) {
+      fail("round trip of cycle did not restore the cycle");
+    }
+  }
+
+  /* objects shared between two graphs serialized together are restored as
+   * shared */
+  {
+    Shared<Node> shared(std::in_place, 0);
+    Shared<Node> x(std::in_place, 1), y(std::in_place, 2);
+    x.get()->other = shared;
+    y.get()->other = shared;
+    Serializer serializer;
+    serializer.visit(x, y);
+    auto& bytes = serializer.data();
+    Deserializer deserializer(bytes.data(), bytes.size());
+    auto x1 = deserializer.read<Shared<Node>>();
+    auto y1 = deserializer.read<Shared<Node>>();
+    if (!deserializer.empty() || x1.get()->value != 1 ||
+        y1.get()->value != 2 ||
+        x1.get()->other.value().get() != y1.get()->other.value().get() ||
+        x1.get()->other.value().get() == shared.get()) {
+      fail("round trip of shared object failed");
+    }
+  }
+
+  /* a bridged graph is restored with its bridges, so that a lazy copy of
+   * it is correct; the graph is a chain of bridges into a cycle */
+  {
+    Shared<Node> x(std::in_place, -2);
+    x.get()->next = Shared<Node>(std::in_place, -1);
+    x.get()->next.value().get()->next = make_cycle(5);
+    x.bridge();
+
+    auto y = deserialize(serialize(x));
+    auto z = y.copy();
+    if (z.load() != y.load()) {
+      fail("restored graph lost its bridges, so that the copy is eager");
+    }
+    Node* y_cycle = follow(y.get(), 2);
+    Node* z_cycle = follow(z.get(), 2);
+    z_cycle->name = "copied";
+    if (z_cycle == y_cycle || !check_cycle(y_cycle, 5) ||
+        z_cycle->name != "copied" || y.get()->value != -2 ||
+        z.get()->value != -2) {
+      fail("copy of restored graph failed");
+    }
+    if (follow(z_cycle, 5) != z_cycle || follow(y_cycle, 5) != y_cycle) {
+      fail("copy of restored graph did not keep its cycle");
+    }
+    if (z_cycle->other.value().get() == y_cycle->other.value().get()) {
+      fail("copy of restored graph shares an object with the original");
+    }
+    if (follow(z_cycle, 2)->other.value().get() !=
+        z_cycle->other.value().get()) {
+      fail("copy of restored graph did not keep a shared object");
+    }
+  }
+  collect();
+  return 0;
+}
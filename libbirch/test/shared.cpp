@@ -0,0 +1,226 @@
+/**
+ * @file
+ *
+ * Tests of libbirch::Shared, in particular of the biased reference counts of
+ * libbirch::Any when references are released by threads other than the
+ * owner, and of the last reference optimization.
+ */
+#include "libbirch/libbirch.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace libbirch;
+
+/**
+ * Number of objects alive.
+ */
+static Atomic<int> live(0);
+
+/**
+ * Object that may form cycles.
+ */
+class Node : public Any {
+public:
+  LIBBIRCH_CLASS(Node, Any)
+  LIBBIRCH_CLASS_MEMBERS(next, value)
+
+  Node() {
+    ++live;
+  }
+
+  Node(const Node& o) : Any(o), next(o.next), value(o.value) {
+    ++live;
+  }
+
+  Node(Deserializer& visitor_) :
+      Any(visitor_),
+      next(visitor_.read<std::optional<Shared<Node>>>()),
+      value(visitor_.read<int>()) {
+    ++live;
+  }
+
+  ~Node() {
+    --live;
+  }
+
+  std::optional<Shared<Node>> next;
+  int value = 0;
+};
+
+/**
+ * Object that may not form cycles.
+ */
+class Leaf : public Any {
+public:
+  LIBBIRCH_ACYCLIC_CLASS(Leaf, Any)
+  LIBBIRCH_CLASS_MEMBERS(value)
+
+  Leaf() {
+    ++live;
+  }
+
+  Leaf(const Leaf& o) : Any(o), value(o.value) {
+    ++live;
+  }
+
+  Leaf(Deserializer& visitor_) :
+      Any(visitor_),
+      value(visitor_.read<int>()) {
+    ++live;
+  }
+
+  ~Leaf() {
+    --live;
+  }
+
+  int value = 0;
+};
+
+/**
+ * Report a failure and exit.
+ */
+void fail(const std::string& msg) {
+  std::cerr << msg << std::endl;
+  std::exit(1);
+}
+
+int main() {
+  /* collect() visits the possible roots of each thread of its own team, so
+   * all parallel regions use the same number of threads */
+  #ifdef _OPENMP
+  omp_set_dynamic(0);
+  omp_set_num_threads(2);
+  #else
+  return 77;  // skipped, as multiple threads are needed
+  #endif
+
+  /* two threads release references to the same objects at the same time,
+   * one of them the owner, the other not; every object must be destroyed by
+   * the next collect(), none twice, and none while still referenced (run
+   * with a sanitizer to check the latter) */
+  const int nobjects = 1000, nreps = 200;
+  std::vector<Shared<Node>> nodes, givenNodes;
+  std::vector<Shared<Leaf>> leaves, givenLeaves;
+  #pragma omp parallel
+  {
+    for (int rep = 0; rep < nreps; ++rep) {
+      if (get_thread_num() == 0) {
+        for (int i = 0; i < nobjects; ++i) {
+          nodes.push_back(Shared<Node>());
+          leaves.push_back(Shared<Leaf>());
+        }
+        for (int i = 0; i + 1 < nobjects; i += 2) {
+          nodes[i].get()->next = nodes[i + 1];  // chains
+          if (i % 4 == 0) {
+            nodes[i + 1].get()->next = nodes[i];  // cycles
+          }
+        }
+        givenNodes = nodes;
+        givenLeaves = leaves;
+      }
+      #pragma omp barrier
+      if (get_thread_num() == 0) {
+        nodes.clear();
+        leaves.clear();
+      } else {
+        givenNodes.clear();
+        givenLeaves.clear();
+      }
+      #pragma omp barrier
+    }
+  }
+  collect();
+  if (live.load() != 0) {
+    fail("concurrent release left " + std::to_string(live.load()) +
+        " objects alive");
+  }
+
+  /* a thread that is not the owner releases the last reference to an
+   * object, which references another that remains alive; collect() must
+   * destroy the former and release the latter, but not destroy it */
+  {
+    Shared<Node> y;
+    y.get()->value = 2;
+    Shared<Node> x;
+    x.get()->next = y;
+    #pragma omp parallel
+    {
+      if (get_thread_num() == 1) {
+        x.release();
+      }
+    }
+    collect();
+    if (live.load() != 1 || y.get()->value != 2) {
+      fail("release of chain on non-owner thread failed");
+    }
+    y.release();
+    collect();
+    if (live.load() != 0) {
+      fail("release of chain on non-owner thread left " +
+          std::to_string(live.load()) + " objects alive");
+    }
+  }
+
+  /* the last reference optimization applies only where the count can be
+   * determined; a thread that is not the owner cannot determine it while it
+   * is biased, and must copy */
+  {
+    Shared<Node> x;
+    x.get()->value = 1;
+    x.bridge();
+    Shared<Node> y = x.copy();
+    Node* o = x.load();
+    Node* p = nullptr;
+    #pragma omp parallel
+    {
+      if (get_thread_num() == 1) {
+        p = y.get();
+        p->value = 2;
+      }
+    }
+    if (p == o || x.get()->value != 1 || y.get()->value != 2) {
+      fail("copy on non-owner thread failed");
+    }
+  }
+  {
+    Shared<Node> x;
+    x.get()->value = 1;
+    x.bridge();
+    Shared<Node> y = x.copy();
+    Node* o = x.load();
+    x.release();
+    if (y.get() != o || y.get()->value != 1) {
+      fail("last reference optimization on owner thread failed");
+    }
+  }
+  {
+    /* releasing a bridge ends the bias, so that the count is then exact on
+     * any thread */
+    Shared<Node> x;
+    x.bridge();
+    Shared<Node> y = x.copy();
+    Node* o = x.load();
+    x.release();
+    Node* p = nullptr;
+    #pragma omp parallel
+    {
+      if (get_thread_num() == 1) {
+        p = y.get();
+      }
+    }
+    if (p != o) {
+      fail("last reference optimization on non-owner thread failed");
+    }
+  }
+  collect();
+  if (live.load() != 0) {
+    fail("last reference tests left " + std::to_string(live.load()) +
+        " objects alive");
+  }
+  return 0;
+}
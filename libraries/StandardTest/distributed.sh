@@ -0,0 +1,11 @@
+#!/bin/bash
+set -eov pipefail
+
+# Runs DistributedParticleFilter over two processes on the local host, each
+# of which compares its estimates against those of ParticleFilter, see
+# test_filter. Set BIRCH_PORT to use other ports than the default.
+export BIRCH_NRANKS=2
+BIRCH_RANK=1 birch test_filter --filter DistributedParticleFilter &
+RANK1=$!
+BIRCH_RANK=0 birch test_filter --filter DistributedParticleFilter
+wait $RANK1
@@ -13,3 +13,6 @@ eval "`grep -r "program test_pdf_" src       | sed -E "s/^.*program ([A-Za-z0-9_
 eval "`grep -r "program test_pdf_" src       | sed -E "s/^.*program ([A-Za-z0-9_]+).*$/birch \1 -N $N -B $B -S $S --lazy true/"  | sort`"
 eval "`grep -r "program test_conjugacy_" src | sed -E "s/^.*program ([A-Za-z0-9_]+).*$/birch \1 -N $N --lazy false/"             | sort`"
 eval "`grep -r "program test_conjugacy_" src | sed -E "s/^.*program ([A-Za-z0-9_]+).*$/birch \1 -N $N --lazy true/"              | sort`"
+eval "`grep -r "program test_batch_" src     | sed -E "s/^.*program ([A-Za-z0-9_]+).*$/birch \1 -N $N/"                          | sort`"
+eval "`grep -r "program test_special_" src   | sed -E "s/^.*program ([A-Za-z0-9_]+).*$/birch \1 -N $N/"                          | sort`"
+birch test_filter --filter IslandParticleFilter --trigger 0.5 -N 256
@@ -5,6 +5,8 @@ N1=10000  # for cdf tests
 N2=1000   # for gradient tests
 N3=10000  # for pdf tests
 N4=10000  # for conjugacy tests
+N5=10000  # for batch tests
+N6=10000  # for special function tests
 
 eval "`grep -r "program test_basic_" src     | sed -E "s/^.*program ([A-Za-z0-9_]+).*$/birch \1/"                         | sort`"
 eval "`grep -r "program test_cdf_" src       | sed -E "s/^.*program ([A-Za-z0-9_]+).*$/birch \1 -N $N1/"                  | sort`"
@@ -14,3 +16,6 @@ eval "`grep -r "program test_pdf_" src       | sed -E "s/^.*program ([A-Za-z0-9_
 eval "`grep -r "program test_pdf_" src       | sed -E "s/^.*program ([A-Za-z0-9_]+).*$/birch \1 -N $N3 --lazy true/"      | sort`"
 eval "`grep -r "program test_conjugacy_" src | sed -E "s/^.*program ([A-Za-z0-9_]+).*$/birch \1 -N $N4 --lazy false/"     | sort`"
 eval "`grep -r "program test_conjugacy_" src | sed -E "s/^.*program ([A-Za-z0-9_]+).*$/birch \1 -N $N4 --lazy true/"      | sort`"
+eval "`grep -r "program test_batch_" src     | sed -E "s/^.*program ([A-Za-z0-9_]+).*$/birch \1 -N $N5/"                  | sort`"
+eval "`grep -r "program test_special_" src   | sed -E "s/^.*program ([A-Za-z0-9_]+).*$/birch \1 -N $N6/"                  | sort`"
+birch test_filter --filter IslandParticleFilter --trigger 0.5